@@ -0,0 +1,58 @@
+//
+// Created by Daniil Ryzhkov on 17/10/2026.
+//
+
+#include "integration_tests_common/benchmark.hpp"
+#include "base_api_integration_test.hpp"
+#include "../src/api.hpp"
+#include "mocks/factories.hpp"
+
+using namespace api::integration_tests;
+
+#define BENCHMARK_REQUESTS 2000
+
+class api_setup_benchmark : public base_api_integration_test {
+ protected:
+  // Unknown route passes identity from the user cache and every middleware without touching the database.
+  rest::api_request_t create_api_request() {
+    return lambda::json::deserialize<rest::api_request_t>(create_request("GET", "/v1/unknown", "").payload);
+  }
+
+  // Returns size of not found responses as work, so that both ways must pass the same middleware and routes.
+  template<typename TInvoke>
+  benchmark::measurement measure_request_latency(TInvoke &&invoke) {
+    auto request = create_api_request();
+    return benchmark::measure<std::micro>(BENCHMARK_REQUESTS, [&]() {
+      auto scope = services.begin_scope();
+      auto response = invoke(request);
+      EXPECT_EQ(response.status_code, 404);
+      return response.status_code == 404 ? response.body.size() + 1 : 0;
+    });
+  }
+};
+
+TEST_F(api_setup_benchmark, per_request_latency) {
+  init_user();
+  (*api)(create_api_request());
+
+  auto rebuilt = measure_request_latency([this](const auto &request) {
+    // as the handler did, building routes and middleware for every invocation
+    auto per_request_api = api::create_api(services);
+    return (*per_request_api)(request);
+  });
+  auto reused = measure_request_latency([this](const auto &request) {
+    return (*api)(request);
+  });
+
+  benchmark::compare("Per request latency building api for every request vs reusing it", "us", rebuilt, reused);
+}
+
+TEST_F(api_setup_benchmark, scope_should_reset_identity) {
+  init_user();
+  {
+    auto scope = services.begin_scope();
+    (*api)(create_api_request());
+    ASSERT_EQ(services.get<api::identity>()->user_id, api::guid_t(USER_ID));
+  }
+  ASSERT_TRUE(services.get<api::identity>()->user_id.is_nil());
+}
@@ -17,23 +17,25 @@ std::shared_ptr<sql::Connection> base_api_integration_test::get_connection() {
 
 void base_api_integration_test::SetUp() {
   repository_integration_test::SetUp();
+  // database is recreated for each test, while cache lives as long as the singleton
+  services.get<user_cache>()->clear();
   api = std::move(create_api(services));
 }
 
 void base_api_integration_test::init_user() {
   auto repo = services.get<repository::t_client>();
   repo->create(repository::models::user {
-    .id = USER_ID
+    .id = guid_t(USER_ID)
   });
 }
 
 repository::models::budget base_api_integration_test::create_budget(const lambda::nullable<int>& version) {
   auto repo = services.get<repository::t_client>();
   auto b = repository::models::budget{
-      .id = TEST_BUDGET,
-      .user_id = USER_ID,
+      .id = guid_t(TEST_BUDGET),
+      .user_id = guid_t(USER_ID),
       .month = "2024-07-01",
-      .amount = 1500.0,
+      .amount = repository::models::money::from_cents(150000),
       .version = version.has_value() ? version.get_value() : 0,
   };
   repo->create<repository::models::budget>(b);
@@ -43,8 +45,8 @@ repository::models::budget base_api_integration_test::create_budget(const lambda
 repository::models::category base_api_integration_test::create_category(const lambda::nullable<int>& version) {
   auto repo = services.get<repository::t_client>();
   auto c = repository::models::category{
-      .id = TEST_CATEGORY,
-      .user_id = USER_ID,
+      .id = guid_t(TEST_CATEGORY),
+      .user_id = guid_t(USER_ID),
       .name = "category",
       .color = 29,
       .icon = 62345,
@@ -57,10 +59,10 @@ repository::models::category base_api_integration_test::create_category(const la
 repository::models::receipt base_api_integration_test::create_receipt(const lambda::nullable<int>& version) {
   auto repo = services.get<repository::t_client>();
   auto r = repository::models::receipt{
-      .id = TEST_RECEIPT,
-      .user_id = USER_ID,
+      .id = guid_t(TEST_RECEIPT),
+      .user_id = guid_t(USER_ID),
       .date = "2024-08-04",
-      .total_amount = 100,
+      .total_amount = repository::models::money::from_cents(10000),
       .currency = "EUR",
       .store_name = "store",
       .category = "",
@@ -75,10 +77,10 @@ repository::models::receipt base_api_integration_test::create_receipt(const lamb
 repository::models::receipt_item base_api_integration_test::create_receipt_item(int sort_order) {
   auto repo = services.get<repository::t_client>();
   auto r = repository::models::receipt_item{
-      .id = Aws::Utils::UUID::RandomUUID(),
-      .receipt_id = TEST_RECEIPT,
+      .id = guid_t::parse(Aws::String(Aws::Utils::UUID::RandomUUID())),
+      .receipt_id = guid_t(TEST_RECEIPT),
       .description = "item",
-      .amount = 100,
+      .amount = repository::models::money::from_cents(10000),
       .category = "supermarket",
       .sort_order = sort_order,
   };
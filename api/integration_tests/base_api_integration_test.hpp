@@ -13,9 +13,11 @@
 #include "repository/connection_settings.hpp"
 #include "repository/client.hpp"
 #include "rest/api_root.hpp"
+#include "repository/factories.hpp"
 
 #include "../src/s3_settings.hpp"
 #include "../src/cognito_settings.hpp"
+#include "../src/user_cache.hpp"
 #include "../src/identity.hpp"
 #include "../src/services/user_service.hpp"
 #include "../src/services/file_service.hpp"
@@ -25,6 +27,7 @@
 #include "mocks/mock_s3_client.hpp"
 #include "mocks/mock_cognito_idp_client.hpp"
 #include "../src/services/budget_service.hpp"
+#include "../src/services/changes_service.hpp"
 #include "../src/http_request.hpp"
 
 #define USER_ID "d394a832-4011-7023-c519-afe3adaf0233"
@@ -43,8 +46,11 @@ class base_api_integration_test : public repository_integration_test {
       di::singleton<Aws::Client::ClientConfiguration>,
 
       di::singleton<repository::connection_settings>,
+      di::singleton<repository::connection_pool>,
+      di::singleton<repository::replica_pool>,
       di::singleton<s3_settings>,
       di::singleton<cognito_settings>,
+      di::singleton<user_cache>,
 
       di::singleton<Aws::S3::S3Client, mocks::mock_s3_client>,
       di::singleton<Aws::CognitoIdentityProvider::CognitoIdentityProviderClient, mocks::mock_cognito_idp_client>,
@@ -60,7 +66,8 @@ class base_api_integration_test : public repository_integration_test {
       di::transient<services::t_budget_service, services::budget_service<>>,
       di::transient<services::t_category_service, services::category_service<>>,
       di::transient<services::t_file_service, services::file_service<>>,
-      di::transient<services::t_receipt_service, services::receipt_service<>>
+      di::transient<services::t_receipt_service, services::receipt_service<>>,
+      di::transient<services::t_changes_service, services::changes_service<>>
   > services;
   void init_user();
 
@@ -45,10 +45,10 @@ TEST_F(budget_test, put_budget) {
   ASSERT_EQ(budgets->size(), 1);
 
   auto b = budgets->at(0);
-  ASSERT_EQ(b->id, TEST_BUDGET);
-  ASSERT_EQ(b->user_id, USER_ID);
+  ASSERT_EQ(b->id, guid_t(TEST_BUDGET));
+  ASSERT_EQ(b->user_id, guid_t(USER_ID));
   ASSERT_EQ(b->month, "2024-07-01");
-  ASSERT_EQ(b->amount, 1500.0);
+  ASSERT_EQ(b->amount, ::models::money::from_cents(150000));
   ASSERT_EQ(b->version, 0);
 }
 
@@ -71,7 +71,7 @@ TEST_F(budget_test, put_budget_update) {
 
   auto b = budgets->at(0);
   ASSERT_EQ(b->version, 1);
-  ASSERT_EQ(b->amount, 1200.0);
+  ASSERT_EQ(b->amount, ::models::money::from_cents(120000));
 }
 
 TEST_F(budget_test, put_budget_update_conflict) {
@@ -115,18 +115,16 @@ TEST_F(budget_test, get_budgets) {
 TEST_F(budget_test, get_changes_should_return_empty_list) {
   init_user();
 
-  auto today = lambda::utils::today();
-  auto response = (*api)(create_request("GET", (ENDPOINT "/changes?from=") + today + "T00:00:00Z", ""));
-  assert_response(response, "200", R"([])");
+  auto response = (*api)(create_request("GET", ENDPOINT "/changes", ""));
+  assert_response(response, "200", R"({"changes":[],"next":"0"})");
 }
 
 TEST_F(budget_test, get_changes_should_return_budgets) {
   init_user();
   create_budget();
 
-  auto today = lambda::utils::today();
-  auto response = (*api)(create_request("GET", (ENDPOINT "/changes?from=") + today + "T00:00:00Z", ""));
-  assert_response(response, "200", R"([
+  auto response = (*api)(create_request("GET", ENDPOINT "/changes", ""));
+  assert_response(response, "200", R"({"changes":[
 {
   "action": "create",
   "body": {
@@ -136,20 +134,19 @@ TEST_F(budget_test, get_changes_should_return_budgets) {
     "version":0
   },
   "id": ")" TEST_BUDGET R"("
-}])");
+}],"next":"1"})");
 }
 
 TEST_F(budget_test, get_changes_should_return_update) {
   init_user();
   auto b = create_budget();
   auto repo = services.get<repository::t_client>();
-  b.amount = 1200.0;
+  b.amount = ::models::money::from_cents(120000);
   b.version++;
   repo->update(b);
 
-  auto today = lambda::utils::today();
-  auto response = (*api)(create_request("GET", (ENDPOINT "/changes?from=") + today + "T00:00:00Z", ""));
-  assert_response(response, "200", R"([
+  auto response = (*api)(create_request("GET", ENDPOINT "/changes", ""));
+  assert_response(response, "200", R"({"changes":[
 {
   "action": "update",
   "body": {
@@ -159,7 +156,7 @@ TEST_F(budget_test, get_changes_should_return_update) {
     "version":1
   },
   "id": ")" TEST_BUDGET R"("
-}])");
+}],"next":"2"})");
 }
 
 }
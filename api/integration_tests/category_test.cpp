@@ -46,8 +46,8 @@ TEST_F(category_test, put_category) {
   ASSERT_EQ(categories->size(), 1);
 
   auto c = categories->at(0);
-  ASSERT_EQ(c->id, TEST_CATEGORY);
-  ASSERT_EQ(c->user_id, USER_ID);
+  ASSERT_EQ(c->id, guid_t(TEST_CATEGORY));
+  ASSERT_EQ(c->user_id, guid_t(USER_ID));
   ASSERT_EQ(c->name, "category");
   ASSERT_EQ(c->color, 29);
   ASSERT_EQ(c->version, 0);
@@ -72,8 +72,8 @@ TEST_F(category_test, put_category_update) {
   ASSERT_EQ(categories->size(), 1);
 
   auto c = categories->at(0);
-  ASSERT_EQ(c->id, TEST_CATEGORY);
-  ASSERT_EQ(c->user_id, USER_ID);
+  ASSERT_EQ(c->id, guid_t(TEST_CATEGORY));
+  ASSERT_EQ(c->user_id, guid_t(USER_ID));
   ASSERT_EQ(c->name, "category2");
   ASSERT_EQ(c->color, 30);
   ASSERT_EQ(c->version, 1);
@@ -123,6 +123,36 @@ TEST_F(category_test, get_categories) {
 ])");
 }
 
+TEST_F(category_test, uppercase_id_should_be_returned_in_lowercase) {
+  init_user();
+
+  // ids are stored as bytes, so their case is not preserved
+  auto response = (*api)(create_request("PUT", ENDPOINT, R"(
+{
+  "id": "D394A832-4011-7023-C519-AFE3ADAF0233",
+  "name": "category",
+  "color": 29,
+  "icon": 62345,
+  "version": 0
+})"));
+  assert_response(response, "200", "");
+
+  response = (*api)(create_request("GET", ENDPOINT, ""));
+  assert_response(response, "200", R"(
+[
+  {
+    "color": 29,
+    "icon": 62345,
+    "id": "d394a832-4011-7023-c519-afe3adaf0233",
+    "name": "category",
+    "version": 0
+  }
+])");
+
+  response = (*api)(create_request("DELETE", ENDPOINT "/D394A832-4011-7023-C519-AFE3ADAF0233", ""));
+  assert_response(response, "200", "");
+}
+
 TEST_F(category_test, get_categories_deleted) {
   init_user();
   auto c = create_category();
@@ -161,18 +191,16 @@ TEST_F(category_test, delete_category_not_found) {
 TEST_F(category_test, get_changes_should_return_empty_list) {
   init_user();
 
-  auto today = lambda::utils::today();
-  auto response = (*api)(create_request("GET", (ENDPOINT "/changes?from=") + today + "T00:00:00Z", ""));
-  assert_response(response, "200", R"([])");
+  auto response = (*api)(create_request("GET", ENDPOINT "/changes", ""));
+  assert_response(response, "200", R"({"changes":[],"next":"0"})");
 }
 
 TEST_F(category_test, get_changes_should_return_categories) {
   init_user();
   create_category();
 
-  auto today = lambda::utils::today();
-  auto response = (*api)(create_request("GET", (ENDPOINT "/changes?from=") + today + "T00:00:00Z", ""));
-  assert_response(response, "200", R"([
+  auto response = (*api)(create_request("GET", ENDPOINT "/changes", ""));
+  assert_response(response, "200", R"({"changes":[
 {
   "action": "create",
   "body": {
@@ -183,7 +211,7 @@ TEST_F(category_test, get_changes_should_return_categories) {
     "version":0
   },
   "id": ")" TEST_CATEGORY R"("
-}])");
+}],"next":"1"})");
 }
 
 TEST_F(category_test, get_changes_should_return_update) {
@@ -194,9 +222,8 @@ TEST_F(category_test, get_changes_should_return_update) {
   c.version++;
   repo->update(c);
 
-  auto today = lambda::utils::today();
-  auto response = (*api)(create_request("GET", (ENDPOINT "/changes?from=") + today + "T00:00:00Z", ""));
-  assert_response(response, "200", R"([
+  auto response = (*api)(create_request("GET", ENDPOINT "/changes", ""));
+  assert_response(response, "200", R"({"changes":[
 {
   "action": "update",
   "body": {
@@ -207,7 +234,7 @@ TEST_F(category_test, get_changes_should_return_update) {
     "version":1
   },
   "id": ")" TEST_CATEGORY R"("
-}])");
+}],"next":"2"})");
 }
 
 TEST_F(category_test, get_changes_should_return_delete) {
@@ -219,14 +246,31 @@ TEST_F(category_test, get_changes_should_return_delete) {
   c.is_deleted = true;
   repo->update(c);
 
-  auto today = lambda::utils::today();
-  auto response = (*api)(create_request("GET", (ENDPOINT "/changes?from=") + today + "T00:00:00Z", ""));
-  assert_response(response, "200", R"([
+  auto response = (*api)(create_request("GET", ENDPOINT "/changes", ""));
+  assert_response(response, "200", R"({"changes":[
 {
   "action": "delete",
   "body": null,
   "id": ")" TEST_CATEGORY R"("
-}])");
+}],"next":"2"})");
+}
+
+TEST_F(category_test, get_changes_should_return_page_after_token) {
+  init_user();
+  create_category();
+
+  auto response = (*api)(create_request("GET", ENDPOINT "/changes?after=1&limit=10", ""));
+  assert_response(response, "200", R"({"changes":[],"next":"1"})");
+}
+
+TEST_F(category_test, get_changes_should_validate_limit) {
+  init_user();
+
+  auto response = (*api)(create_request("GET", ENDPOINT "/changes?limit=0", ""));
+  assert_response(response, "400", R"({"error":1,"message":"Invalid limit"})");
+
+  response = (*api)(create_request("GET", ENDPOINT "/changes?after=abc", ""));
+  assert_response(response, "400", R"({"error":1,"message":"Invalid after"})");
 }
 
 }
@@ -0,0 +1,143 @@
+//
+// Created by Daniil Ryzhkov on 17/10/2026.
+//
+
+#include "base_api_integration_test.hpp"
+#include "lambda/string_utils.hpp"
+
+#define ENDPOINT "/v1/changes"
+
+namespace api::integration_tests {
+
+const std::string BUDGET_CHANGE = R"(
+{
+  "action": "create",
+  "body": {
+    "amount":1500.0,
+    "id": ")" TEST_BUDGET R"(",
+    "month": "2024-07-01",
+    "version":0
+  },
+  "id": ")" TEST_BUDGET R"("
+})";
+
+const std::string CATEGORY_CHANGE = R"(
+{
+  "action": "create",
+  "body": {
+    "color":29,
+    "icon": 62345,
+    "id": ")" TEST_CATEGORY R"(",
+    "name": "category",
+    "version":0
+  },
+  "id": ")" TEST_CATEGORY R"("
+})";
+
+const std::string RECEIPT_CHANGE = R"(
+{
+  "action": "create",
+  "body": {
+    "categories":["supermarket"],
+    "currency":"EUR",
+    "date":"2024-08-04",
+    "id": ")" TEST_RECEIPT R"(",
+    "imageName":"image",
+    "items":[
+      {
+        "amount":100,
+        "category":"supermarket",
+        "description":"item",
+        "id": "%s"
+      }
+    ],
+    "state":"done",
+    "storeName":"store",
+    "totalAmount":100,
+    "version":0
+  },
+  "id": ")" TEST_RECEIPT R"("
+})";
+
+class changes_test : public base_api_integration_test {};
+
+TEST_F(changes_test, get_changes_should_return_empty_lists) {
+  init_user();
+
+  auto response = (*api)(create_request("GET", ENDPOINT, ""));
+  assert_response(response, "200", R"({"budgets":[],"categories":[],"receipts":[],"next":"0"})");
+}
+
+TEST_F(changes_test, get_changes_should_return_all_entities) {
+  init_user();
+  create_budget();
+  create_category();
+  create_receipt();
+  auto ri = create_receipt_item(0);
+
+  auto response = (*api)(create_request("GET", ENDPOINT, ""));
+  assert_response(response, "200", lambda::string::format(
+      (R"({"budgets":[)" + BUDGET_CHANGE + R"(],"categories":[)" + CATEGORY_CHANGE +
+          R"(],"receipts":[)" + RECEIPT_CHANGE + R"(],"next":"3"})").c_str(),
+      ri.id.str().c_str()));
+}
+
+TEST_F(changes_test, get_changes_should_page_across_entities) {
+  init_user();
+  create_budget();
+  create_category();
+  create_receipt();
+  auto ri = create_receipt_item(0);
+
+  auto response = (*api)(create_request("GET", ENDPOINT "?limit=2", ""));
+  assert_response(response, "200",
+                  R"({"budgets":[)" + BUDGET_CHANGE + R"(],"categories":[)" + CATEGORY_CHANGE +
+                      R"(],"receipts":[],"next":"2"})");
+
+  response = (*api)(create_request("GET", ENDPOINT "?after=2&limit=2", ""));
+  assert_response(response, "200", lambda::string::format(
+      (R"({"budgets":[],"categories":[],"receipts":[)" + RECEIPT_CHANGE + R"(],"next":"3"})").c_str(),
+      ri.id.str().c_str()));
+}
+
+TEST_F(changes_test, get_changes_should_validate_after) {
+  init_user();
+
+  auto response = (*api)(create_request("GET", ENDPOINT "?after=abc", ""));
+  assert_response(response, "400", R"({"error":1,"message":"Invalid after"})");
+}
+
+TEST_F(changes_test, bootstrap_should_return_current_state) {
+  init_user();
+  create_budget();
+  create_category();
+  create_receipt();
+  auto ri = create_receipt_item(0);
+
+  auto response = (*api)(create_request("GET", ENDPOINT "/bootstrap", ""));
+  assert_response(response, "200", lambda::string::format(
+      (R"({"budgets":[)" + BUDGET_CHANGE + R"(],"categories":[)" + CATEGORY_CHANGE +
+          R"(],"receipts":[)" + RECEIPT_CHANGE + R"(],"next":"3"})").c_str(),
+      ri.id.str().c_str()));
+}
+
+TEST_F(changes_test, bootstrap_should_skip_deleted_entities) {
+  init_user();
+  auto c = create_category();
+  auto repo = services.get<repository::t_client>();
+  c.version++;
+  c.is_deleted = true;
+  repo->update(c);
+
+  auto response = (*api)(create_request("GET", ENDPOINT "/bootstrap", ""));
+  assert_response(response, "200", R"({"budgets":[],"categories":[],"receipts":[],"next":"2"})");
+}
+
+TEST_F(changes_test, bootstrap_should_return_empty_state) {
+  init_user();
+
+  auto response = (*api)(create_request("GET", ENDPOINT "/bootstrap", ""));
+  assert_response(response, "200", R"({"budgets":[],"categories":[],"receipts":[],"next":"0"})");
+}
+
+}
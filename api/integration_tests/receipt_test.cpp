@@ -72,10 +72,10 @@ TEST_F(receipt_test, put_receipt) {
   ASSERT_EQ(receipts->size(), 1);
 
   auto r = receipts->at(0);
-  ASSERT_EQ(r->id, TEST_RECEIPT);
-  ASSERT_EQ(r->user_id, USER_ID);
+  ASSERT_EQ(r->id, guid_t(TEST_RECEIPT));
+  ASSERT_EQ(r->user_id, guid_t(USER_ID));
   ASSERT_EQ(r->date, "2024-08-04");
-  ASSERT_EQ(r->total_amount, 100);
+  ASSERT_EQ(r->total_amount, ::models::money::from_cents(10000));
   ASSERT_EQ(r->currency, "EUR");
   ASSERT_EQ(r->store_name, "store");
   ASSERT_EQ(r->category, "");
@@ -87,10 +87,10 @@ TEST_F(receipt_test, put_receipt) {
   ASSERT_EQ(items->size(), 1);
 
   auto i = items->at(0);
-  ASSERT_EQ(i->id, "d394a832-4011-7023-c519-afe3adaf0233");
-  ASSERT_EQ(i->receipt_id, TEST_RECEIPT);
+  ASSERT_EQ(i->id, guid_t("d394a832-4011-7023-c519-afe3adaf0233"));
+  ASSERT_EQ(i->receipt_id, guid_t(TEST_RECEIPT));
   ASSERT_EQ(i->description, "item");
-  ASSERT_EQ(i->amount, 100);
+  ASSERT_EQ(i->amount, ::models::money::from_cents(10000));
   ASSERT_EQ(i->category, "supermarket");
   ASSERT_EQ(i->sort_order, 0);
 }
@@ -120,10 +120,10 @@ TEST_F(receipt_test, put_receipt_update) {
   ASSERT_EQ(receipts->size(), 1);
 
   auto r = receipts->at(0);
-  ASSERT_EQ(r->id, TEST_RECEIPT);
-  ASSERT_EQ(r->user_id, USER_ID);
+  ASSERT_EQ(r->id, guid_t(TEST_RECEIPT));
+  ASSERT_EQ(r->user_id, guid_t(USER_ID));
   ASSERT_EQ(r->date, "2024-08-04");
-  ASSERT_EQ(r->total_amount, 100);
+  ASSERT_EQ(r->total_amount, ::models::money::from_cents(10000));
   ASSERT_EQ(r->currency, "EUR");
   ASSERT_EQ(r->store_name, "store");
   ASSERT_EQ(r->category, "");
@@ -186,7 +186,7 @@ TEST_F(receipt_test, get_receipts_by_month) {
     "totalAmount": 100,
     "version": 0
   }
-])", i.id.c_str()));
+])", i.id.str().c_str()));
 
   response = (*api)(create_request("GET", ENDPOINT "/years/2024/months/7", ""));
   assert_response(response, "200", "[]");
@@ -208,6 +208,55 @@ TEST_F(receipt_test, get_receipts_by_month_deleted) {
   assert_response(response, "200", "[]");
 }
 
+TEST_F(receipt_test, get_receipts_by_date_range) {
+  init_user();
+  create_receipt();
+  auto i = create_receipt_item(0);
+
+  auto response = (*api)(create_request("GET", ENDPOINT "?from=2024-08-04&to=2024-08-05", ""));
+  assert_response(response, "200", lambda::string::format(R"([
+  {
+    "categories": ["supermarket"],
+    "currency": "EUR",
+    "date": "2024-08-04",
+    "id": "d394a832-4011-7023-c519-afe3adaf0233",
+    "imageName": "image",
+    "items": [
+      {
+        "amount": 100,
+        "category": "supermarket",
+        "description": "item",
+        "id": "%s"
+      }
+    ],
+    "state": "done",
+    "storeName": "store",
+    "totalAmount": 100,
+    "version": 0
+  }
+])", i.id.str().c_str()));
+
+  // upper bound is exclusive
+  response = (*api)(create_request("GET", ENDPOINT "?from=2024-08-01&to=2024-08-04", ""));
+  assert_response(response, "200", "[]");
+}
+
+TEST_F(receipt_test, get_receipts_by_date_range_invalid) {
+  init_user();
+
+  auto response = (*api)(create_request("GET", ENDPOINT "?from=2024-08-05&to=2024-08-04", ""));
+  assert_response(response, "400", R"({"error":1,"message":"Invalid date range"})");
+
+  response = (*api)(create_request("GET", ENDPOINT "?from=2024-8-1&to=2024-09-01", ""));
+  assert_response(response, "400", R"({"error":1,"message":"Invalid date range"})");
+
+  response = (*api)(create_request("GET", ENDPOINT "?from=2024-02-01&to=2024-02-31", ""));
+  assert_response(response, "400", R"({"error":1,"message":"Invalid date range"})");
+
+  response = (*api)(create_request("GET", ENDPOINT "?from=2023-02-29&to=2023-03-01", ""));
+  assert_response(response, "400", R"({"error":1,"message":"Invalid date range"})");
+}
+
 TEST_F(receipt_test, delete_receipt) {
   init_user();
   create_receipt();
@@ -238,6 +287,29 @@ TEST_F(receipt_test, delete_receipt_not_found) {
   ASSERT_EQ(receipts->size(), 1);
 }
 
+TEST_F(receipt_test, put_receipt_invalid_id) {
+  init_user();
+
+  auto response = (*api)(create_request("PUT", ENDPOINT, R"(
+{
+  "id": "receipt_1",
+  "date": "2024-08-04",
+  "totalAmount": 100,
+  "currency": "EUR",
+  "storeName": "store",
+  "category": "",
+  "state": "done",
+  "imageName": "image",
+  "version": 0,
+  "items": []
+})"));
+  assert_response(response, "400", R"({"error":1,"message":"Invalid id"})");
+
+  auto repo = services.get<repository::t_client>();
+  auto receipts = repo->select<::models::receipt>("select * from receipts").all();
+  ASSERT_EQ(receipts->size(), 0);
+}
+
 TEST_F(receipt_test, get_receipt_image) {
   init_user();
   create_receipt();
@@ -301,9 +373,8 @@ TEST_F(receipt_test, post_receipt_image_not_found) {
 TEST_F(receipt_test, get_changes_should_return_empty_list) {
   init_user();
 
-  auto today = lambda::utils::today();
-  auto response = (*api)(create_request("GET", (ENDPOINT "/changes?from=") + today + "T00:00:00Z", ""));
-  assert_response(response, "200", R"([])");
+  auto response = (*api)(create_request("GET", ENDPOINT "/changes", ""));
+  assert_response(response, "200", R"({"changes":[],"next":"0"})");
 }
 
 TEST_F(receipt_test, get_changes_should_return_receipts) {
@@ -311,9 +382,8 @@ TEST_F(receipt_test, get_changes_should_return_receipts) {
   auto r = create_receipt();
   auto ri = create_receipt_item(0);
 
-  auto today = lambda::utils::today();
-  auto response = (*api)(create_request("GET", (ENDPOINT "/changes?from=") + today + "T00:00:00Z", ""));
-  assert_response(response, "200", lambda::string::format(R"([
+  auto response = (*api)(create_request("GET", ENDPOINT "/changes", ""));
+  assert_response(response, "200", lambda::string::format(R"({"changes":[
 {
   "action": "create",
   "body": {
@@ -336,7 +406,7 @@ TEST_F(receipt_test, get_changes_should_return_receipts) {
     "version":0
   },
   "id": ")" TEST_RECEIPT R"("
-}])", ri.id.c_str()));
+}],"next":"1"})", ri.id.str().c_str()));
 }
 
 TEST_F(receipt_test, get_changes_should_return_update) {
@@ -344,13 +414,12 @@ TEST_F(receipt_test, get_changes_should_return_update) {
   auto r = create_receipt();
   auto ri = create_receipt_item(0);
   auto repo = services.get<repository::t_client>();
-  r.total_amount = 120;
+  r.total_amount = ::models::money::from_cents(12000);
   r.version++;
   repo->update(r);
 
-  auto today = lambda::utils::today();
-  auto response = (*api)(create_request("GET", (ENDPOINT "/changes?from=") + today + "T00:00:00Z", ""));
-  assert_response(response, "200",  lambda::string::format(R"([
+  auto response = (*api)(create_request("GET", ENDPOINT "/changes", ""));
+  assert_response(response, "200",  lambda::string::format(R"({"changes":[
 {
   "action": "update",
   "body": {
@@ -373,7 +442,7 @@ TEST_F(receipt_test, get_changes_should_return_update) {
     "version":1
   },
   "id": ")" TEST_RECEIPT R"("
-}])", ri.id.c_str()));
+}],"next":"2"})", ri.id.str().c_str()));
 }
 
 TEST_F(receipt_test, get_changes_should_return_delete) {
@@ -381,19 +450,18 @@ TEST_F(receipt_test, get_changes_should_return_delete) {
   auto r = create_receipt();
   create_receipt_item(0);
   auto repo = services.get<repository::t_client>();
-  r.total_amount = 120;
+  r.total_amount = ::models::money::from_cents(12000);
   r.version++;
   r.is_deleted = true;
   repo->update(r);
 
-  auto today = lambda::utils::today();
-  auto response = (*api)(create_request("GET", (ENDPOINT "/changes?from=") + today + "T00:00:00Z", ""));
-  assert_response(response, "200", R"([
+  auto response = (*api)(create_request("GET", ENDPOINT "/changes", ""));
+  assert_response(response, "200", R"({"changes":[
 {
   "action": "delete",
   "body": null,
   "id": ")" TEST_RECEIPT R"("
-}])");
+}],"next":"2"})");
 }
 
 TEST_F(receipt_test, get_changes_should_merge_receipt_categories) {
@@ -402,9 +470,8 @@ TEST_F(receipt_test, get_changes_should_merge_receipt_categories) {
   auto ri1 = create_receipt_item(0);
   auto ri2 = create_receipt_item(1);
 
-  auto today = lambda::utils::today();
-  auto response = (*api)(create_request("GET", (ENDPOINT "/changes?from=") + today + "T00:00:00Z", ""));
-  assert_response(response, "200", lambda::string::format(R"([
+  auto response = (*api)(create_request("GET", ENDPOINT "/changes", ""));
+  assert_response(response, "200", lambda::string::format(R"({"changes":[
 {
   "action": "create",
   "body": {
@@ -433,7 +500,7 @@ TEST_F(receipt_test, get_changes_should_merge_receipt_categories) {
     "version":0
   },
   "id": ")" TEST_RECEIPT R"("
-}])", ri1.id.c_str(), ri2.id.c_str()));
+}],"next":"1"})", ri1.id.str().c_str(), ri2.id.str().c_str()));
 }
 
 }
@@ -22,7 +22,7 @@ TEST_F(user_test, post_user) {
   auto repo = services.get<repository::t_client>();
   auto users = repo->select<::models::user>("select * from users").all();
   ASSERT_EQ(users->size(), 1);
-  ASSERT_EQ(users->at(0)->id, USER_ID);
+  ASSERT_EQ(users->at(0)->id, guid_t(USER_ID));
 
   // initializing same user once again is no-op
   response = (*api)(create_request("POST", ENDPOINT, ""));
@@ -30,7 +30,7 @@ TEST_F(user_test, post_user) {
 
   users = repo->select<::models::user>("select * from users").all();
   ASSERT_EQ(users->size(), 1);
-  ASSERT_EQ(users->at(0)->id, USER_ID);
+  ASSERT_EQ(users->at(0)->id, guid_t(USER_ID));
 }
 
 TEST_F(user_test, get_user) {
@@ -77,4 +77,27 @@ TEST_F(user_test, delete_user) {
   assert_response(response, "200", "");
 }
 
+TEST_F(user_test, should_cache_initialized_user) {
+  (*api)(create_request("POST", ENDPOINT, ""));
+  auto users = services.get<user_cache>();
+  auto before = users->get_stats();
+
+  auto response = (*api)(create_request("GET", "/v1/categories", ""));
+  assert_response(response, "200", "[]");
+  response = (*api)(create_request("GET", "/v1/categories", ""));
+  assert_response(response, "200", "[]");
+
+  auto after = users->get_stats();
+  ASSERT_EQ(after.hits, before.hits + 2);
+  ASSERT_EQ(after.misses, before.misses);
+}
+
+TEST_F(user_test, should_invalidate_cached_user_on_delete) {
+  (*api)(create_request("POST", ENDPOINT, ""));
+  (*api)(create_request("DELETE", ENDPOINT, ""));
+
+  auto response = (*api)(create_request("GET", "/v1/categories", ""));
+  assert_response(response, "400", R"({"error":4,"message":"User is not initialized"})");
+}
+
 }
@@ -11,12 +11,14 @@
 #include "identity.hpp"
 #include "http_request.hpp"
 #include "model_types.hpp"
+#include "user_cache.hpp"
 
 #include "services/user_service.hpp"
 #include "services/file_service.hpp"
 #include "services/receipt_service.hpp"
 #include "services/category_service.hpp"
 #include "services/budget_service.hpp"
+#include "services/changes_service.hpp"
 
 namespace api {
 
@@ -27,13 +29,13 @@ template<typename TServiceContainer>
 std::unique_ptr<api_root> create_api(TServiceContainer &c) {
   std::unique_ptr<api_root> api = std::make_unique<api_root>();
 
-  // Middleware
+  // Middleware, the first one is the innermost
 
   // Identity
-  api->use([&c](const auto &request, const auto &next) {
+  auto identity_middleware = [&c](const auto &request, const auto &next) {
     auto auth = request.request_context.authorizer;
-    auto user_id = auth.claims["sub"];
-    if (user_id.empty()) {
+    guid_t user_id;
+    if (!guid_t::try_parse(auth.claims["sub"], user_id)) {
       return rest::unauthorized();
     }
 
@@ -41,35 +43,38 @@ std::unique_ptr<api_root> create_api(TServiceContainer &c) {
     i->user_id = user_id;
 
     if (request.path == "/v1/user") return next(request);
-    auto repo = c.template get<repository::t_client>();
-    auto users = repo->template select<repository::models::user>("select * from users where id = ?")
-        .with_param(user_id)
-        .all();
-    if (users->size() == 0) {
-      return rest::bad_request(rest::api_exception(user_not_initialized, "User is not initialized"));
+    auto users = c.template get<user_cache>();
+    if (!users->contains(user_id)) {
+      auto repo = c.template get<repository::t_client>();
+      // user may have just been initialized by another container
+      auto user = repo->template select<repository::models::user>("select * from users where id = ?",
+                                                                   repository::read_route::primary)
+          .with_param(user_id)
+          .first_or_default();
+      if (!user) {
+        return rest::bad_request(rest::api_exception(user_not_initialized, "User is not initialized"));
+      }
+      users->add(user_id);
     }
 
     return next(request);
-  });
-
-  // Logging
-  api->use_logging();
+  };
 
   // Version
-  api->use([](const auto &request, const auto &next) {
+  auto version_middleware = [](const auto &request, const auto &next) {
     lambda::log.info("App Version: %s", APP_VERSION);
     return next(request);
-  });
+  };
 
   // Http request storage
-  api->use([&c](const auto &request, const auto &next) {
+  auto http_request_middleware = [&c](const auto &request, const auto &next) {
     auto r = c.template get<http_request>();
     r->current = request;
     return next(request);
-  });
+  };
 
   // Error handling
-  api->use([](const auto &request, const auto &next) {
+  auto error_handling_middleware = [](const auto &request, const auto &next) {
     try {
       return next(request);
     } catch (rest::api_exception &e) {
@@ -86,10 +91,10 @@ std::unique_ptr<api_root> create_api(TServiceContainer &c) {
       lambda::log.error("Internal error: %s", e.what());
       return rest::internal_server_error();
     }
-  });
+  };
 
   // CORS
-  api->use([&c](const auto &request, const auto &next) {
+  auto cors_middleware = [&c](const auto &request, const auto &next) {
     auto response = request.http_method == "OPTIONS"
         ? rest::no_content()
         : next(request);
@@ -107,7 +112,14 @@ std::unique_ptr<api_root> create_api(TServiceContainer &c) {
     }
 
     return response;
-  });
+  };
+
+  api->use(identity_middleware,
+           rest::logging_middleware(),
+           version_middleware,
+           http_request_middleware,
+           error_handling_middleware,
+           cors_middleware);
 
   // Routes
 
@@ -133,7 +145,9 @@ std::unique_ptr<api_root> create_api(TServiceContainer &c) {
       });
       budgets.get("/changes")([&c]() {
         auto request = c.template get<http_request>()->current;
-        return c.template get<services::t_budget_service>()->get_changes(request.query_string_parameters["from"]);
+        return c.template get<services::t_budget_service>()->get_changes(parameters::get_changes::parse(
+            request.query_string_parameters["after"],
+            request.query_string_parameters["limit"]));
       });
     });
 
@@ -149,25 +163,33 @@ std::unique_ptr<api_root> create_api(TServiceContainer &c) {
       });
       categories.get("/changes")([&c]() {
         auto request = c.template get<http_request>()->current;
-        return c.template get<services::t_category_service>()->get_changes(request.query_string_parameters["from"]);
+        return c.template get<services::t_category_service>()->get_changes(parameters::get_changes::parse(
+            request.query_string_parameters["after"],
+            request.query_string_parameters["limit"]));
       });
     });
 
     v1.any("/receipts")([&c](api_resource &receipts) {
+      receipts.get("/")([&c]() {
+        auto request = c.template get<http_request>()->current;
+        return c.template get<services::t_receipt_service>()->get_receipts(
+            request.query_string_parameters["from"],
+            request.query_string_parameters["to"]);
+      });
       receipts.any("/years")([&c](api_resource &years) {
-        years.any<int>()([&c](const int &y, api_resource &year) {
-          year.any("/months")([&c, &y](api_resource &months) {
-            months.get<int>()([&c, &y](const int &m) {
+        years.any<int>()([&c](rest::basic_api_resource<int> &year) {
+          year.any("/months")([&c](rest::basic_api_resource<int> &months) {
+            months.get<int>()([&c](const int &y, const int &m) {
               return c.template get<services::t_receipt_service>()->get_receipts(y, m);
             });
           });
         });
       });
-      receipts.any<guid_t>()([&c](const guid_t &receipt_id, api_resource &receipt) {
-        receipt.get("/image")([&c, &receipt_id]() {
+      receipts.any<guid_t>()([&c](rest::basic_api_resource<guid_t> &receipt) {
+        receipt.get("/image")([&c](const guid_t &receipt_id) {
           return c.template get<services::t_receipt_service>()->get_receipt_get_image_url(receipt_id);
         });
-        receipt.post("/image")([&c, &receipt_id]() {
+        receipt.post("/image")([&c](const guid_t &receipt_id) {
           return c.template get<services::t_receipt_service>()->get_receipt_put_image_url(receipt_id);
         });
       });
@@ -179,7 +201,21 @@ std::unique_ptr<api_root> create_api(TServiceContainer &c) {
       });
       receipts.get("/changes")([&c]() {
         auto request = c.template get<http_request>()->current;
-        return c.template get<services::t_receipt_service>()->get_changes(request.query_string_parameters["from"]);
+        return c.template get<services::t_receipt_service>()->get_changes(parameters::get_changes::parse(
+            request.query_string_parameters["after"],
+            request.query_string_parameters["limit"]));
+      });
+    });
+
+    v1.any("/changes")([&c](api_resource &changes) {
+      changes.get("/")([&c]() {
+        auto request = c.template get<http_request>()->current;
+        return c.template get<services::t_changes_service>()->get_changes(parameters::get_changes::parse(
+            request.query_string_parameters["after"],
+            request.query_string_parameters["limit"]));
+      });
+      changes.get("/bootstrap")([&c]() {
+        return c.template get<services::t_changes_service>()->bootstrap();
       });
     });
   });
@@ -19,6 +19,7 @@
 #include "identity.hpp"
 #include "s3_settings.hpp"
 #include "cognito_settings.hpp"
+#include "user_cache.hpp"
 
 #include "services/file_service.hpp"
 #include "services/user_service.hpp"
@@ -67,4 +68,16 @@ struct service_factory<api::cognito_settings> {
   }
 };
 
+template<>
+struct service_factory<api::user_cache> {
+  template<typename TContainer, typename TPointerFactory>
+  static auto create(TContainer &container, TPointerFactory &&factory) {
+    auto ttl_env = getenv("USER_CACHE_TTL_SECONDS");
+    std::chrono::milliseconds ttl = ttl_env == nullptr
+        ? api::user_cache::DEFAULT_TTL
+        : std::chrono::seconds(std::stol(ttl_env));
+    return std::move(factory(ttl));
+  }
+};
+
 }
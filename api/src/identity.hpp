@@ -4,12 +4,12 @@
 
 #pragma once
 
-#include <string>
+#include "model_types.hpp"
 
 namespace api {
 
 struct identity {
-  std::string user_id;
+  guid_t user_id;
 };
 
 }
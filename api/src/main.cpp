@@ -34,33 +34,46 @@ int main(int argc, char** argv) {
   {
     lambda::log = lambda::logger("Api");
 
-    auto function = [](auto req) {
-      container<
-          singleton<Aws::Client::ClientConfiguration>,
-
-          singleton<repository::connection_settings>,
-          singleton<s3_settings>,
-          singleton<cognito_settings>,
-
-          singleton<Aws::S3::S3Client>,
-          singleton<Aws::CognitoIdentityProvider::CognitoIdentityProviderClient>,
-
-          singleton<repository::t_client, repository::client<>>,
-          transient<repository::t_category_repository, repository::category_repository<>>,
-          transient<repository::t_receipt_repository, repository::receipt_repository<>>,
-
-          scoped<identity>,
-          scoped<http_request>,
-
-          transient<t_user_service, user_service<>>,
-          transient<t_budget_service, budget_service<>>,
-          transient<t_category_service, category_service<>>,
-          transient<t_file_service, file_service<>>,
-          transient<t_receipt_service, receipt_service<>>
-      > services;
-
-      auto api = create_api(services);
-      return (*api)(req);
+    // Routes and middleware capture the container, both live as long as the lambda container
+    container<
+        singleton<Aws::Client::ClientConfiguration>,
+
+        singleton<repository::connection_settings>,
+        singleton<repository::connection_pool>,
+        singleton<repository::replica_pool>,
+        singleton<s3_settings>,
+        singleton<cognito_settings>,
+        singleton<user_cache>,
+
+        singleton<Aws::S3::S3Client>,
+        singleton<Aws::CognitoIdentityProvider::CognitoIdentityProviderClient>,
+
+        singleton<repository::t_client, repository::client<>>,
+        transient<repository::t_category_repository, repository::category_repository<>>,
+        transient<repository::t_receipt_repository, repository::receipt_repository<>>,
+
+        scoped<identity>,
+        scoped<http_request>,
+
+        transient<t_user_service, user_service<>>,
+        transient<t_budget_service, budget_service<>>,
+        transient<t_category_service, category_service<>>,
+        transient<t_file_service, file_service<>>,
+        transient<t_receipt_service, receipt_service<>>,
+        transient<t_changes_service, changes_service<>>
+    > services;
+    auto api = create_api(services);
+
+    auto function = [&services, &api](auto req) {
+      // identity and http request are scoped to the invocation
+      auto scope = services.begin_scope();
+      auto response = (*api)(req);
+      const auto &user_id = services.get<identity>()->user_id;
+      services.get<repository::t_client>()->flush_metrics(user_id.is_nil() ? std::string() : user_id.str());
+      auto user_cache_stats = services.get<user_cache>()->get_stats();
+      lambda::log.info("User cache hits: %zu, misses: %zu, hit rate: %.2f",
+                       user_cache_stats.hits, user_cache_stats.misses, user_cache_stats.hit_rate());
+      return response;
     };
 
 #ifdef DEBUG
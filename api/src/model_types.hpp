@@ -4,10 +4,38 @@
 
 #pragma once
 
+#include <string>
+
+#include <rest/api_exception.hpp>
+#include <rest/parsing.hpp>
+
 #include "repository/models/common.hpp"
+#include "api_errors.hpp"
 
 namespace api {
 
 typedef repository::models::guid guid_t;
+typedef repository::models::money money_t;
+
+// Parses id sent in a request body, bodies carry ids in text form.
+inline guid_t parse_guid(const std::string &text) {
+  guid_t id;
+  if (!guid_t::try_parse(text, id)) {
+    throw rest::api_exception(invalid_argument, "Invalid id");
+  }
+  return id;
+}
 
 }
+
+// Route with an invalid id in the path is not found.
+template<>
+struct rest::parser<api::guid_t> {
+  static api::guid_t parse(std::string_view s) {
+    return api::guid_t::parse(s);
+  }
+
+  static bool try_parse(std::string_view s, api::guid_t &output) {
+    return api::guid_t::try_parse(s, output);
+  }
+};
@@ -0,0 +1,33 @@
+//
+// Created by Daniil Ryzhkov on 17/10/2026.
+//
+
+#include "get_changes.hpp"
+
+#include <charconv>
+
+#include <rest/api_exception.hpp>
+
+#include "../api_errors.hpp"
+
+namespace api::parameters {
+
+template<typename T>
+static bool parse_number(const std::string &value, T &result) {
+  auto end = value.data() + value.size();
+  auto [ptr, ec] = std::from_chars(value.data(), end, result);
+  return ec == std::errc() && ptr == end;
+}
+
+get_changes get_changes::parse(const std::string &after, const std::string &limit) {
+  get_changes result;
+  if (!after.empty() && (!parse_number(after, result.after) || result.after < 0)) {
+    throw rest::api_exception(invalid_argument, "Invalid after");
+  }
+  if (!limit.empty() && (!parse_number(limit, result.limit) || result.limit < 1 || result.limit > MAX_LIMIT)) {
+    throw rest::api_exception(invalid_argument, "Invalid limit");
+  }
+  return result;
+}
+
+}
@@ -0,0 +1,23 @@
+//
+// Created by Daniil Ryzhkov on 17/10/2026.
+//
+
+#pragma once
+
+#include <string>
+
+namespace api::parameters {
+
+// Keyset of a changes page: changes with sequence greater than after, at most limit of them.
+struct get_changes {
+  static constexpr int DEFAULT_LIMIT = 100;
+  static constexpr int MAX_LIMIT = 1000;
+
+  long after = 0;
+  int limit = DEFAULT_LIMIT;
+
+  // Parses query string parameters, empty values are defaulted.
+  static get_changes parse(const std::string &after, const std::string &limit);
+};
+
+}
@@ -7,12 +7,12 @@
 namespace api {
 namespace parameters {
 
-repository::models::budget put_budget::to_repo(const std::string &user_id) const {
+repository::models::budget put_budget::to_repo(const guid_t &user_id) const {
   return repository::models::budget{
-      id,
+      parse_guid(id),
       user_id,
       month,
-      amount,
+      money_t::from_floating(amount),
       version
   };
 }
@@ -12,9 +12,9 @@
 namespace api::parameters {
 
 struct put_budget {
-  guid_t id;
+  std::string id;
   std::string month;
-  long double amount;
+  double amount;
   int version;
 
   JSON_BEGIN_SERIALIZER(put_budget)
@@ -24,7 +24,7 @@ struct put_budget {
       JSON_PROPERTY("version", version)
   JSON_END_SERIALIZER()
 
-  [[nodiscard]] repository::models::budget to_repo(const std::string &user_id) const;
+  [[nodiscard]] repository::models::budget to_repo(const guid_t &user_id) const;
 };
 
 }
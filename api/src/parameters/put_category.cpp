@@ -6,9 +6,9 @@
 
 namespace api::parameters {
 
-repository::models::category parameters::put_category::to_repo(const std::string &user_id) const {
+repository::models::category parameters::put_category::to_repo(const guid_t &user_id) const {
   return repository::models::category{
-      .id = id,
+      .id = parse_guid(id),
       .user_id = user_id,
       .name = name,
       .color = color,
@@ -12,7 +12,7 @@
 namespace api::parameters {
 
 struct put_category {
-  guid_t id;
+  std::string id;
   std::string name;
   int color;
   lambda::nullable<int> icon;
@@ -26,7 +26,7 @@ struct put_category {
       JSON_PROPERTY("version", version)
   JSON_END_SERIALIZER()
 
-  [[nodiscard]] repository::models::category to_repo(const std::string &user_id) const;
+  [[nodiscard]] repository::models::category to_repo(const guid_t &user_id) const;
 };
 
 }
@@ -11,7 +11,7 @@ namespace api {
 namespace parameters {
 
 struct put_device {
-  guid_t id;
+  std::string id;
 
   JSON_BEGIN_SERIALIZER(put_device)
       JSON_PROPERTY("id", id)
@@ -7,19 +7,20 @@
 namespace api {
 namespace parameters {
 
-repository::models::receipt parameters::put_receipt::to_repo(const std::string &user_id) const {
+repository::models::receipt parameters::put_receipt::to_repo(const guid_t &user_id) const {
+  auto receipt_id = parse_guid(id);
   std::vector<repository::models::receipt_item> repo_items;
   repo_items.reserve(items.size());
   for (int i = 0; i < items.size(); i++) {
     const auto &item = items[i];
-    repo_items.push_back(item.to_repo(id, i));
+    repo_items.push_back(item.to_repo(receipt_id, i));
   }
 
   return repository::models::receipt{
-      .id = id,
+      .id = receipt_id,
       .user_id = user_id,
       .date = date,
-      .total_amount = total_amount,
+      .total_amount = money_t::from_floating(total_amount),
       .currency = currency,
       .store_name = store_name,
       .category = category.has_value() ? category.get_value() : "",
@@ -13,9 +13,9 @@ namespace api {
 namespace parameters {
 
 struct put_receipt {
-  guid_t id;
+  std::string id;
   std::string date;
-  long double total_amount = 0;
+  double total_amount = 0;
   std::string currency;
   std::string store_name;
   lambda::nullable<std::string> category;
@@ -37,7 +37,7 @@ struct put_receipt {
       JSON_PROPERTY("items", items)
   JSON_END_SERIALIZER()
 
-  repository::models::receipt to_repo(const std::string &user_id) const;
+  repository::models::receipt to_repo(const guid_t &user_id) const;
 };
 
 }
@@ -9,10 +9,10 @@ namespace parameters {
 
 repository::models::receipt_item put_receipt_item::to_repo(const guid_t &receipt_id, int index) const {
   return repository::models::receipt_item{
-      .id = id,
+      .id = parse_guid(id),
       .receipt_id = receipt_id,
       .description = description,
-      .amount = amount,
+      .amount = money_t::from_floating(amount),
       .category = category,
       .sort_order = index,
   };
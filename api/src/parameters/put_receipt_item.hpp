@@ -11,9 +11,9 @@ namespace api {
 namespace parameters {
 
 struct put_receipt_item {
-  guid_t id;
+  std::string id;
   std::string description;
-  long double amount;
+  double amount;
   std::string category;
 
   JSON_BEGIN_SERIALIZER(put_receipt_item)
@@ -9,9 +9,9 @@ namespace responses {
 
 budget budget::from_repo(const repository::models::budget &b) {
   return budget{
-      b.id,
+      b.id.str(),
       b.month,
-      b.amount,
+      b.amount.to_floating(),
       b.version
   };
 }
@@ -13,9 +13,9 @@ namespace api {
 namespace responses {
 
 struct budget {
-  guid_t id;
+  std::string id;
   std::string month;
-  long double amount;
+  double amount;
   int version;
 
   JSON_BEGIN_SERIALIZER(budget)
@@ -8,7 +8,7 @@ namespace api::responses {
 
 category responses::category::from_repo(const repository::models::category &c) {
   return category{
-      .id = c.id,
+      .id = c.id.str(),
       .name = c.name,
       .color = c.color,
       .icon = c.icon == 0 ? lambda::nullable<int>() : lambda::nullable<int>(c.icon),
@@ -12,7 +12,7 @@
 namespace api::responses {
 
 struct category {
-  guid_t id;
+  std::string id;
   std::string name;
   int color;
   lambda::nullable<int> icon;
@@ -5,6 +5,7 @@
 #pragma once
 
 #include <string>
+#include <vector>
 #include <lambda/nullable.hpp>
 #include <lambda/json.hpp>
 #include "../model_types.hpp"
@@ -22,7 +23,7 @@ inline static constexpr auto del = "delete";
 template<typename T>
 struct change {
   std::string action;
-  guid_t id;
+  std::string id;
   lambda::nullable<T> body;
 
   JSON_BEGIN_SERIALIZER(change<T>)
@@ -32,4 +33,32 @@ struct change {
   JSON_END_SERIALIZER()
 };
 
+// Makes change of the stored entity, deleted entities are sent without body.
+template<typename T, typename TModel>
+change<T> make_change(const TModel &model) {
+  bool is_deleted = false;
+  if constexpr (requires { model.is_deleted; }) {
+    is_deleted = model.is_deleted;
+  }
+  return change<T>{
+      .action = is_deleted
+                ? change_action::del
+                : (model.version == 0 ? change_action::create : change_action::update),
+      .id = model.id.str(),
+      .body = is_deleted ? lambda::nullable<T>{} : T::from_repo(model),
+  };
+}
+
+// Page of changes in order they were made. Next is the token to request changes after this page.
+template<typename T>
+struct change_page {
+  std::vector<change<T>> changes;
+  std::string next;
+
+  JSON_BEGIN_SERIALIZER(change_page<T>)
+      JSON_PROPERTY("changes", changes)
+      JSON_PROPERTY("next", next)
+  JSON_END_SERIALIZER()
+};
+
 }
@@ -0,0 +1,34 @@
+//
+// Created by Daniil Ryzhkov on 17/10/2026.
+//
+
+#pragma once
+
+#include <string>
+#include <vector>
+
+#include <lambda/json.hpp>
+
+#include "budget.hpp"
+#include "category.hpp"
+#include "change.hpp"
+#include "receipt.hpp"
+
+namespace api::responses {
+
+// Changes of all entities of the user. Next is the token to request changes after these.
+struct changes {
+  std::vector<change<budget>> budgets;
+  std::vector<change<category>> categories;
+  std::vector<change<receipt>> receipts;
+  std::string next;
+
+  JSON_BEGIN_SERIALIZER(changes)
+      JSON_PROPERTY("budgets", budgets)
+      JSON_PROPERTY("categories", categories)
+      JSON_PROPERTY("receipts", receipts)
+      JSON_PROPERTY("next", next)
+  JSON_END_SERIALIZER()
+};
+
+}
@@ -24,9 +24,9 @@ receipt receipt::from_repo(const repository::models::receipt &receipt) {
   }
 
   return {
-      .id = receipt.id,
+      .id = receipt.id.str(),
       .date = receipt.date,
-      .total_amount = receipt.total_amount,
+      .total_amount = receipt.total_amount.to_floating(),
       .currency = receipt.currency,
       .store_name = receipt.store_name,
       .categories = categories,
@@ -17,9 +17,9 @@ namespace api {
 namespace responses {
 
 struct receipt {
-  guid_t id;
+  std::string id;
   std::string date;
-  long double total_amount = 0;
+  double total_amount = 0;
   std::string currency;
   std::string store_name;
   std::vector<std::string> categories;
@@ -9,9 +9,9 @@ namespace responses {
 
 receipt_item responses::receipt_item::from_repo(const repository::models::receipt_item &item) {
   return {
-      .id = item.id,
+      .id = item.id.str(),
       .description = item.description,
-      .amount = item.amount,
+      .amount = item.amount.to_floating(),
       .category = item.category,
   };
 }
@@ -12,9 +12,9 @@ namespace api {
 namespace responses {
 
 struct receipt_item {
-  guid_t id;
+  std::string id;
   std::string description;
-  long double amount = 0;
+  double amount = 0;
   std::string category;
 
   JSON_BEGIN_SERIALIZER(receipt_item)
@@ -9,7 +9,7 @@ namespace responses {
 
 user user::from_repository(const repository::models::user &u) {
   return {
-      .id = u.id,
+      .id = u.id.str(),
   };
 }
 
@@ -12,7 +12,7 @@
 namespace api::responses {
 
 struct user {
-  guid_t id;
+  std::string id;
 
   JSON_BEGIN_SERIALIZER(user)
       JSON_PROPERTY("id", id)
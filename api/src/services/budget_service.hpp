@@ -8,6 +8,7 @@
 #include "../identity.hpp"
 #include "../responses/budget.hpp"
 #include "../parameters/put_budget.hpp"
+#include "../parameters/get_changes.hpp"
 #include "../responses/change.hpp"
 namespace api {
 namespace services {
@@ -23,49 +24,33 @@ class budget_service {
       : m_repository(std::move(repository)), m_identity(std::move(identity)) {}
 
   std::vector<responses::budget> get_budgets() {
-    auto budgets = m_repository->template select<repository::models::budget>("select * from budgets where user_id = ?")
-        .with_param(m_identity->user_id)
-        .all();
-
     std::vector<responses::budget> result;
-    result.reserve(budgets->size());
-    for (const auto &b : (*budgets)) {
-      result.push_back(responses::budget::from_repo(*b));
-    }
+    m_repository->template select<repository::models::budget>("select * from budgets where user_id = ?")
+        .with_param(m_identity->user_id)
+        .for_each([&result](const repository::models::budget &b) {
+          result.push_back(responses::budget::from_repo(b));
+        });
 
     return result;
   }
 
   void store_budget(const parameters::put_budget &params) {
-    auto existing = m_repository->template select<repository::models::budget>("select * from budgets where id = ?")
-        .with_param(params.id)
-        .first_or_default();
-    auto new_budget = params.to_repo(m_identity->user_id);
-    if (existing) {
-      m_repository->template update<repository::models::budget>(new_budget);
-    } else {
-      m_repository->template create<repository::models::budget>(new_budget);
-    }
+    m_repository->template upsert<repository::models::budget>(params.to_repo(m_identity->user_id));
   }
 
-  std::vector<responses::change<responses::budget>> get_changes(const std::string &since) {
-    auto budgets = m_repository->template select<repository::models::budget>(
-            "select * from budgets where user_id = ? and modified_timestamp > ?")
+  responses::change_page<responses::budget> get_changes(const parameters::get_changes &query) {
+    responses::change_page<responses::budget> result;
+    auto after = query.after;
+    m_repository->template select<repository::models::budget>(
+            "select * from budgets where user_id = ? and change_seq > ? order by change_seq limit ?")
         .with_param(m_identity->user_id)
-        .with_param(since)
-        .all();
-
-    std::vector<responses::change<responses::budget>> result;
-    result.reserve(budgets->size());
-    for (const auto &b : (*budgets)) {
-      result.push_back(responses::change<responses::budget>{
-          .action = b->version == 0
-                    ? responses::change_action::create
-                    : responses::change_action::update,
-          .id = b->id,
-          .body = responses::budget::from_repo(*b),
-      });
-    }
+        .with_param(query.after)
+        .with_param(query.limit)
+        .for_each([&result, &after](const repository::models::budget &b) {
+          result.changes.push_back(responses::make_change<responses::budget>(b));
+          after = b.change_seq;
+        });
+    result.next = std::to_string(after);
 
     return result;
   }
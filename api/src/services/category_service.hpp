@@ -9,6 +9,7 @@
 #include "../identity.hpp"
 #include "../responses/category.hpp"
 #include "../parameters/put_category.hpp"
+#include "../parameters/get_changes.hpp"
 #include "../responses/change.hpp"
 
 namespace api::services {
@@ -44,23 +45,15 @@ class category_service {
     m_repository->drop(category_id);
   }
 
-  std::vector<responses::change<responses::category>> get_changes(const std::string &since) {
-    auto categories = m_repository->get_changed(m_identity->user_id, since);
+  responses::change_page<responses::category> get_changes(const parameters::get_changes &query) {
+    auto categories = m_repository->get_changed(m_identity->user_id, query.after, query.limit);
 
-    std::vector<responses::change<responses::category>> response;
-    for (auto c : categories) {
-      response.push_back(responses::change<responses::category>{
-          .action = c.is_deleted
-                    ? responses::change_action::del
-                    : (c.version == 0
-                       ? responses::change_action::create
-                       : responses::change_action::update),
-          .id = c.id,
-          .body = c.is_deleted
-                  ? lambda::nullable<responses::category>{}
-                  : responses::category::from_repo(c),
-      });
+    responses::change_page<responses::category> response;
+    response.changes.reserve(categories.size());
+    for (const auto &c : categories) {
+      response.changes.push_back(responses::make_change<responses::category>(c));
     }
+    response.next = std::to_string(categories.empty() ? query.after : categories.back().change_seq);
 
     return response;
   }
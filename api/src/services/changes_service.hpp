@@ -5,7 +5,9 @@
 #pragma once
 
 #include "repository/client.hpp"
+#include "repository/receipt_repository.hpp"
 #include "../identity.hpp"
+#include "../parameters/get_changes.hpp"
 #include "../responses/changes.hpp"
 
 namespace api {
@@ -22,11 +24,132 @@ class changes_service {
       : m_repository(std::move(repository)),
         m_identity(std::move(identity)) {}
 
+  // Returns at most limit changes of all entities after the change sequence, in one round trip.
+  // Upper bound of the page is the limit-th smallest sequence across all tables,
+  // so every entity type is cut at the same point and no change is skipped by the next page.
+  // Changes are read from the replica, unless it has not caught up with the sequence yet.
+  responses::changes get_changes(const parameters::get_changes &query) {
+    long sequence = 0;
+    auto result = read_changes(query, repository::read_route::replica, sequence);
+    if (sequence < query.after) {
+      // replica has not applied changes the device has already seen, so it has no newer ones
+      lambda::log.info("Replica is behind change %ld at %ld, reading changes from the primary", query.after, sequence);
+      result = read_changes(query, repository::read_route::primary, sequence);
+    }
+    return result;
+  }
 
+  // Returns whole current state of the user for a fresh device, in one round trip.
+  // Sequence is read first, so changes made while reading are sent again by the next changes request.
+  responses::changes bootstrap() {
+    const auto &user_id = m_identity->user_id;
+    auto reader = m_repository->query_batch(
+        repository::batch()
+            .add("select * from change_sequences where user_id = ?")
+            .with_param(user_id)
+            .add("select * from budgets where user_id = ?")
+            .with_param(user_id)
+            .add("select * from categories where user_id = ? and is_deleted = 0")
+            .with_param(user_id)
+            .add("select * from receipts where user_id = ? and is_deleted = 0")
+            .with_param(user_id)
+            .add("select ri.* from receipt_items ri "
+                 "join receipts r on ri.receipt_id = r.id "
+                 "where r.user_id = ? and r.is_deleted = 0 "
+                 "order by ri.receipt_id, ri.sort_order")
+            .with_param(user_id));
+
+    auto sequences = reader.template next<repository::models::change_sequence>();
+    auto budgets = reader.template next<repository::models::budget>();
+    auto categories = reader.template next<repository::models::category>();
+    auto receipts = reader.template next<repository::models::receipt>();
+    auto receipt_items = reader.template next<repository::models::receipt_item>();
+
+    auto result = make_changes(std::move(budgets),
+                               std::move(categories),
+                               std::move(receipts),
+                               std::move(receipt_items));
+    result.next = std::to_string(sequences.empty() ? 0 : sequences.front().seq);
+    return result;
+  }
 
  private:
   TRepository m_repository;
   TIdentity m_identity;
+
+  responses::changes read_changes(const parameters::get_changes &query, repository::read_route route, long &sequence) {
+    const auto &user_id = m_identity->user_id;
+    auto reader = m_repository->query_batch(
+        repository::batch()
+            .add("select * from change_sequences where user_id = ?")
+            .with_param(user_id)
+            .add("set @upper = (select max(change_seq) from ("
+                 "(select change_seq from budgets where user_id = ? and change_seq > ? order by change_seq limit ?) "
+                 "union all "
+                 "(select change_seq from categories where user_id = ? and change_seq > ? order by change_seq limit ?) "
+                 "union all "
+                 "(select change_seq from receipts where user_id = ? and change_seq > ? order by change_seq limit ?) "
+                 "order by change_seq limit ?) changes)")
+            .with_param(user_id).with_param(query.after).with_param(query.limit)
+            .with_param(user_id).with_param(query.after).with_param(query.limit)
+            .with_param(user_id).with_param(query.after).with_param(query.limit)
+            .with_param(query.limit)
+            .add("select * from budgets "
+                 "where user_id = ? and change_seq > ? and change_seq <= @upper order by change_seq")
+            .with_param(user_id).with_param(query.after)
+            .add("select * from categories "
+                 "where user_id = ? and change_seq > ? and change_seq <= @upper order by change_seq")
+            .with_param(user_id).with_param(query.after)
+            .add("select * from receipts "
+                 "where user_id = ? and change_seq > ? and change_seq <= @upper order by change_seq")
+            .with_param(user_id).with_param(query.after)
+            .add("select ri.* from receipt_items ri "
+                 "join receipts r on ri.receipt_id = r.id "
+                 "where r.user_id = ? and r.change_seq > ? and r.change_seq <= @upper and r.is_deleted = 0 "
+                 "order by ri.receipt_id, ri.sort_order")
+            .with_param(user_id).with_param(query.after),
+        route);
+
+    auto sequences = reader.template next<repository::models::change_sequence>();
+    auto budgets = reader.template next<repository::models::budget>();
+    auto categories = reader.template next<repository::models::category>();
+    auto receipts = reader.template next<repository::models::receipt>();
+    auto receipt_items = reader.template next<repository::models::receipt_item>();
+    sequence = sequences.empty() ? 0 : sequences.front().seq;
+
+    auto next = query.after;
+    for (const auto &b : budgets) next = std::max(next, b.change_seq);
+    for (const auto &c : categories) next = std::max(next, c.change_seq);
+    for (const auto &r : receipts) next = std::max(next, r.change_seq);
+
+    auto result = make_changes(std::move(budgets),
+                               std::move(categories),
+                               std::move(receipts),
+                               std::move(receipt_items));
+    result.next = std::to_string(next);
+    return result;
+  }
+
+  static responses::changes make_changes(std::vector<repository::models::budget> budgets,
+                                         std::vector<repository::models::category> categories,
+                                         std::vector<repository::models::receipt> receipts,
+                                         std::vector<repository::models::receipt_item> receipt_items) {
+    responses::changes result;
+    result.budgets.reserve(budgets.size());
+    for (const auto &b : budgets) {
+      result.budgets.push_back(responses::make_change<responses::budget>(b));
+    }
+    result.categories.reserve(categories.size());
+    for (const auto &c : categories) {
+      result.categories.push_back(responses::make_change<responses::category>(c));
+    }
+    receipts = repository::receipt_repository<>::assemble_models(std::move(receipts), std::move(receipt_items));
+    result.receipts.reserve(receipts.size());
+    for (const auto &r : receipts) {
+      result.receipts.push_back(responses::make_change<responses::receipt>(r));
+    }
+    return result;
+  }
 };
 
 }
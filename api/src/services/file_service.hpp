@@ -77,8 +77,8 @@ class file_service {
     }
   }
 
-  void delete_receipt_images(const std::string &user_id) {
-    auto path_prefix = lambda::string::format("users/%s", user_id.c_str());
+  void delete_receipt_images(const guid_t &user_id) {
+    auto path_prefix = lambda::string::format("users/%s", user_id.str().c_str());
 
     Aws::S3::Model::ListObjectsV2Request list_request;
     list_request.SetBucket(m_bucket);
@@ -129,8 +129,8 @@ class file_service {
   std::string m_bucket;
   TIdentity m_identity;
 
-  static std::string get_receipt_image_key(const std::string &user_id, const std::string &name) {
-    return lambda::string::format("users/%s/receipts/%s", user_id.c_str(), name.c_str());
+  static std::string get_receipt_image_key(const guid_t &user_id, const std::string &name) {
+    return lambda::string::format("users/%s/receipts/%s", user_id.str().c_str(), name.c_str());
   }
 };
 
@@ -4,6 +4,9 @@
 
 #pragma once
 
+#include <cctype>
+#include <chrono>
+
 #include <aws/s3/S3Client.h>
 #include <lambda/string_utils.hpp>
 #include "repository/receipt_repository.hpp"
@@ -11,6 +14,7 @@
 #include "../identity.hpp"
 #include "../responses/receipt.hpp"
 #include "../parameters/put_receipt.hpp"
+#include "../parameters/get_changes.hpp"
 
 #include "file_service.hpp"
 #include "../responses/change.hpp"
@@ -40,6 +44,19 @@ class receipt_service {
     return response;
   }
 
+  std::vector<responses::receipt> get_receipts(const std::string &from, const std::string &to) {
+    if (!is_date(from) || !is_date(to) || from >= to) {
+      throw rest::api_exception(invalid_argument, "Invalid date range");
+    }
+    auto results = m_repository->get_by_date_range(m_identity->user_id, from, to);
+    std::vector<responses::receipt> response;
+    response.reserve(results.size());
+    for (const auto &item : results) {
+      response.push_back(responses::receipt::from_repo(item));
+    }
+    return response;
+  }
+
   responses::file get_receipt_get_image_url(const guid_t &receipt_id) {
     auto r = try_get_receipt(receipt_id);
     return m_file_service->get_download_receipt_image_url(r.image_name);
@@ -63,23 +80,14 @@ class receipt_service {
     }
   }
 
-  std::vector<responses::change<responses::receipt>> get_changes(const std::string &since) {
-    auto results = m_repository->get_changed(m_identity->user_id, since);
-    std::vector<responses::change<responses::receipt>> response;
-    response.reserve(results.size());
+  responses::change_page<responses::receipt> get_changes(const parameters::get_changes &query) {
+    auto results = m_repository->get_changed(m_identity->user_id, query.after, query.limit);
+    responses::change_page<responses::receipt> response;
+    response.changes.reserve(results.size());
     for (const auto &item : results) {
-      response.push_back(responses::change<responses::receipt>{
-          .action = item.is_deleted
-                    ? responses::change_action::del
-                    : (item.version == 0
-                       ? responses::change_action::create
-                       : responses::change_action::update),
-          .id = item.id,
-          .body = item.is_deleted
-                  ? lambda::nullable<responses::receipt>{}
-                  : responses::receipt::from_repo(item),
-      });
+      response.changes.push_back(responses::make_change<responses::receipt>(item));
     }
+    response.next = std::to_string(results.empty() ? query.after : results.back().change_seq);
     return response;
   }
 
@@ -88,6 +96,25 @@ class receipt_service {
   TIdentity m_identity;
   TFileService m_file_service;
 
+  // Checks that the value is an existing date in YYYY-MM-DD format.
+  static bool is_date(const std::string &value) {
+    if (value.size() != 10 || value[4] != '-' || value[7] != '-') {
+      return false;
+    }
+    for (size_t i = 0; i < value.size(); i++) {
+      if (i == 4 || i == 7) continue;
+      if (!std::isdigit(static_cast<unsigned char>(value[i]))) {
+        return false;
+      }
+    }
+    auto year = std::stoi(value.substr(0, 4));
+    auto month = std::stoi(value.substr(5, 2));
+    auto day = std::stoi(value.substr(8, 2));
+    return std::chrono::year_month_day(std::chrono::year(year),
+                                       std::chrono::month(month),
+                                       std::chrono::day(day)).ok();
+  }
+
   repository::models::receipt try_get_receipt(const guid_t &receipt_id) {
     auto result = m_repository->get(receipt_id);
     if (!result.has_value()) {
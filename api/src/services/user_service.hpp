@@ -17,6 +17,7 @@
 #include "../api_errors.hpp"
 #include "../responses/user.hpp"
 #include "../cognito_settings.hpp"
+#include "../user_cache.hpp"
 
 namespace api::services {
 
@@ -27,34 +28,37 @@ template<
     typename TIdentity = const identity,
     typename TFileService = t_file_service,
     typename TCognitoIDP = Aws::CognitoIdentityProvider::CognitoIdentityProviderClient,
-    typename TCognitoSettings = cognito_settings>
+    typename TCognitoSettings = cognito_settings,
+    typename TUserCache = user_cache>
 class user_service {
   using user = repository::models::user;
 
  public:
-  user_service(TRepository repository, TIdentity identity, TFileService file_service, TCognitoIDP cognito, TCognitoSettings cognito_settings)
+  user_service(TRepository repository, TIdentity identity, TFileService file_service, TCognitoIDP cognito, TCognitoSettings cognito_settings, TUserCache user_cache)
       : m_repository(std::move(repository)),
         m_identity(std::move(identity)),
         m_file_service(std::move(file_service)),
         m_cognito(std::move(cognito)),
-        m_user_pool_id(cognito_settings->user_pool_id) {}
+        m_user_pool_id(cognito_settings->user_pool_id),
+        m_user_cache(std::move(user_cache)) {}
 
   void init_user() {
     auto user_id = m_identity->user_id;
 
     auto existing_user =
-        m_repository->template select<user>("select * from users where id = ?")
+        m_repository->template select<user>("select * from users where id = ?", repository::read_route::primary)
             .with_param(user_id)
             .first_or_default();
 
-    if (existing_user) return;
-
-    user user{.id = user_id};
-    m_repository->create(user);
+    if (!existing_user) {
+      user user{.id = user_id};
+      m_repository->create(user);
+    }
+    m_user_cache->add(user_id);
   }
 
   responses::user get_user() {
-    auto users = m_repository->template select<user>("select * from users where id = ?")
+    auto users = m_repository->template select<user>("select * from users where id = ?", repository::read_route::primary)
         .with_param(m_identity->user_id)
         .all();
     if (users->empty()) {
@@ -64,6 +68,7 @@ class user_service {
   }
 
   void delete_user() {
+    m_user_cache->remove(m_identity->user_id);
     delete_data_from_database();
     m_file_service->delete_receipt_images(m_identity->user_id);
     delete_cognito_user();
@@ -75,14 +80,20 @@ class user_service {
   TFileService m_file_service;
   TCognitoIDP m_cognito;
   std::string m_user_pool_id;
+  TUserCache m_user_cache;
 
   void delete_data_from_database() {
     auto user_id = m_identity->user_id;
     try {
-      m_repository->execute("delete from receipts where user_id = ?").with_param(user_id).go();
-      m_repository->execute("delete from categories where user_id = ?").with_param(user_id).go();
-      m_repository->execute("delete from budgets where user_id = ?").with_param(user_id).go();
-      m_repository->execute("delete from users where id = ?").with_param(user_id).go();
+      auto transaction = m_repository->transaction();
+      m_repository->execute_batch(
+          repository::batch()
+              .add("delete from receipts where user_id = ?").with_param(user_id)
+              .add("delete from categories where user_id = ?").with_param(user_id)
+              .add("delete from budgets where user_id = ?").with_param(user_id)
+              .add("delete from change_sequences where user_id = ?").with_param(user_id)
+              .add("delete from users where id = ?").with_param(user_id));
+      transaction.commit();
     } catch (const std::exception &e) {
       lambda::log.error("Failed to delete user data: %s", e.what());
       throw rest::api_exception(internal, "Failed to delete user data");
@@ -90,7 +101,7 @@ class user_service {
   }
 
   void delete_cognito_user() {
-    auto user_id = m_identity->user_id;
+    auto user_id = m_identity->user_id.str();
 
     // Check if the user exists in the pool
     Aws::CognitoIdentityProvider::Model::AdminGetUserRequest get_user_request;
@@ -0,0 +1,87 @@
+//
+// Created by Daniil Ryzhkov on 17/10/2026.
+//
+
+#pragma once
+
+#include <chrono>
+#include <mutex>
+#include <unordered_map>
+
+#include "repository/models/guid.hpp"
+
+namespace api {
+
+struct user_cache_stats {
+  size_t hits = 0;
+  size_t misses = 0;
+
+  [[nodiscard]] double hit_rate() const {
+    auto total = hits + misses;
+    return total == 0 ? 0.0 : (double) hits / (double) total;
+  }
+};
+
+// Ids of initialized users, kept for ttl in a warm container to skip the user lookup.
+class user_cache {
+ public:
+  static constexpr std::chrono::seconds DEFAULT_TTL{60};
+  static constexpr size_t DEFAULT_CAPACITY = 1024;
+
+  user_cache() : user_cache(DEFAULT_TTL) {}
+
+  explicit user_cache(std::chrono::milliseconds ttl, size_t capacity = DEFAULT_CAPACITY)
+      : m_ttl(ttl), m_capacity(capacity) {}
+
+  // Returns whether user is known to be initialized, counting hit or miss.
+  bool contains(const repository::models::guid &user_id) {
+    std::lock_guard lock(m_mutex);
+    auto found = m_users.find(user_id);
+    if (found != m_users.end() && found->second > std::chrono::steady_clock::now()) {
+      m_stats.hits++;
+      return true;
+    }
+    if (found != m_users.end()) {
+      m_users.erase(found);
+    }
+    m_stats.misses++;
+    return false;
+  }
+
+  void add(const repository::models::guid &user_id) {
+    std::lock_guard lock(m_mutex);
+    auto now = std::chrono::steady_clock::now();
+    if (m_users.size() >= m_capacity && !m_users.contains(user_id)) {
+      std::erase_if(m_users, [now](const auto &user) { return user.second <= now; });
+      if (m_users.size() >= m_capacity) {
+        m_users.clear();
+      }
+    }
+    m_users.insert_or_assign(user_id, now + m_ttl);
+  }
+
+  void remove(const repository::models::guid &user_id) {
+    std::lock_guard lock(m_mutex);
+    m_users.erase(user_id);
+  }
+
+  void clear() {
+    std::lock_guard lock(m_mutex);
+    m_users.clear();
+  }
+
+  [[nodiscard]] user_cache_stats get_stats() {
+    std::lock_guard lock(m_mutex);
+    return m_stats;
+  }
+
+ private:
+  std::chrono::milliseconds m_ttl;
+  size_t m_capacity;
+
+  std::mutex m_mutex;
+  std::unordered_map<repository::models::guid, std::chrono::steady_clock::time_point> m_users;
+  user_cache_stats m_stats;
+};
+
+}
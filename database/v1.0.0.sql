@@ -296,3 +296,291 @@ do
 # 2024-09-22: add icon to category
 alter table categories
 add column icon int not null default 0;
+
+# v1.2.0
+# 2026-10-17: add index on receipts to serve listings by date range
+alter table receipts
+add index ix_user_id_is_deleted_date (user_id, is_deleted, `date`);
+
+# 2026-10-17: add per-user change sequence to receipts, categories and budgets
+create table change_sequences (
+  user_id char(36) not null primary key,
+  seq bigint not null
+);
+
+alter table receipts
+add column change_seq bigint not null default 0;
+
+alter table categories
+add column change_seq bigint not null default 0;
+
+alter table budgets
+add column change_seq bigint not null default 0;
+
+set @seq = 0;
+
+update receipts
+set change_seq = (@seq := @seq + 1),
+    modified_timestamp = modified_timestamp
+order by modified_timestamp, id;
+
+update categories
+set change_seq = (@seq := @seq + 1),
+    modified_timestamp = modified_timestamp
+order by modified_timestamp, id;
+
+update budgets
+set change_seq = (@seq := @seq + 1),
+    modified_timestamp = modified_timestamp
+order by modified_timestamp, id;
+
+insert into change_sequences (user_id, seq)
+select user_id, @seq from receipts where user_id is not null
+union select user_id, @seq from categories where user_id is not null
+union select user_id, @seq from budgets where user_id is not null;
+
+alter table receipts
+add index ix_user_id_change_seq (user_id, change_seq);
+
+alter table categories
+add index ix_user_id_change_seq (user_id, change_seq);
+
+alter table budgets
+add index ix_user_id_change_seq (user_id, change_seq);
+
+# 2026-10-17: assign next change sequence of the user on insert and on update changing version
+DELIMITER //
+create trigger receipts_change_seq_insert before insert on receipts for each row
+begin
+  if new.user_id is not null then
+    insert into change_sequences (user_id, seq) values (new.user_id, 1)
+    on duplicate key update seq = seq + 1;
+    set new.change_seq = (select seq from change_sequences where user_id = new.user_id);
+  end if;
+end//
+
+create trigger receipts_change_seq_update before update on receipts for each row
+begin
+  if new.user_id is not null and new.version <> old.version then
+    insert into change_sequences (user_id, seq) values (new.user_id, 1)
+    on duplicate key update seq = seq + 1;
+    set new.change_seq = (select seq from change_sequences where user_id = new.user_id);
+  end if;
+end//
+
+create trigger categories_change_seq_insert before insert on categories for each row
+begin
+  if new.user_id is not null then
+    insert into change_sequences (user_id, seq) values (new.user_id, 1)
+    on duplicate key update seq = seq + 1;
+    set new.change_seq = (select seq from change_sequences where user_id = new.user_id);
+  end if;
+end//
+
+create trigger categories_change_seq_update before update on categories for each row
+begin
+  if new.user_id is not null and new.version <> old.version then
+    insert into change_sequences (user_id, seq) values (new.user_id, 1)
+    on duplicate key update seq = seq + 1;
+    set new.change_seq = (select seq from change_sequences where user_id = new.user_id);
+  end if;
+end//
+
+create trigger budgets_change_seq_insert before insert on budgets for each row
+begin
+  if new.user_id is not null then
+    insert into change_sequences (user_id, seq) values (new.user_id, 1)
+    on duplicate key update seq = seq + 1;
+    set new.change_seq = (select seq from change_sequences where user_id = new.user_id);
+  end if;
+end//
+
+create trigger budgets_change_seq_update before update on budgets for each row
+begin
+  if new.user_id is not null and new.version <> old.version then
+    insert into change_sequences (user_id, seq) values (new.user_id, 1)
+    on duplicate key update seq = seq + 1;
+    set new.change_seq = (select seq from change_sequences where user_id = new.user_id);
+  end if;
+end//
+DELIMITER ;
+
+# 2026-10-17: store ids as binary(16) instead of their text form
+# Ids are converted into new columns, which replace the text ones only after every id is verified.
+# Nothing is changed if an id is not a canonical guid. If the converted ids do not match, the text
+# columns are still in place and the *_bin columns can be dropped.
+set @guid_pattern = '^[0-9a-fA-F]{8}-([0-9a-fA-F]{4}-){3}[0-9a-fA-F]{12}$';
+
+DELIMITER //
+begin not atomic
+  if exists (select 1 from users where id not regexp @guid_pattern)
+     or exists (select 1 from categories where id not regexp @guid_pattern)
+     or exists (select 1 from categories where user_id is not null and user_id not regexp @guid_pattern)
+     or exists (select 1 from receipts where id not regexp @guid_pattern)
+     or exists (select 1 from receipts where user_id not regexp @guid_pattern)
+     or exists (select 1 from receipt_items where id not regexp @guid_pattern)
+     or exists (select 1 from receipt_items where receipt_id not regexp @guid_pattern)
+     or exists (select 1 from budgets where id not regexp @guid_pattern)
+     or exists (select 1 from budgets where user_id not regexp @guid_pattern)
+     or exists (select 1 from change_sequences where user_id not regexp @guid_pattern) then
+    signal sqlstate '45000' set message_text = 'Ids are not canonical guids, migration aborted';
+  end if;
+end//
+DELIMITER ;
+
+alter table users
+add column id_bin binary(16);
+
+alter table categories
+add column id_bin binary(16),
+add column user_id_bin binary(16);
+
+alter table receipts
+add column id_bin binary(16),
+add column user_id_bin binary(16);
+
+alter table receipt_items
+add column id_bin binary(16),
+add column receipt_id_bin binary(16);
+
+alter table budgets
+add column id_bin binary(16),
+add column user_id_bin binary(16);
+
+alter table change_sequences
+add column user_id_bin binary(16);
+
+update users
+set id_bin = unhex(replace(id, '-', ''));
+
+update categories
+set id_bin = unhex(replace(id, '-', '')),
+    user_id_bin = unhex(replace(user_id, '-', '')),
+    modified_timestamp = modified_timestamp;
+
+update receipts
+set id_bin = unhex(replace(id, '-', '')),
+    user_id_bin = unhex(replace(user_id, '-', '')),
+    modified_timestamp = modified_timestamp;
+
+update receipt_items
+set id_bin = unhex(replace(id, '-', '')),
+    receipt_id_bin = unhex(replace(receipt_id, '-', ''));
+
+update budgets
+set id_bin = unhex(replace(id, '-', '')),
+    user_id_bin = unhex(replace(user_id, '-', '')),
+    modified_timestamp = modified_timestamp;
+
+update change_sequences
+set user_id_bin = unhex(replace(user_id, '-', ''));
+
+DELIMITER //
+begin not atomic
+  if exists (select 1 from users where id_bin is null or lower(hex(id_bin)) <> lower(replace(id, '-', '')))
+     or exists (select 1 from categories where id_bin is null or lower(hex(id_bin)) <> lower(replace(id, '-', '')))
+     or exists (select 1 from categories where user_id is not null and (user_id_bin is null or lower(hex(user_id_bin)) <> lower(replace(user_id, '-', ''))))
+     or exists (select 1 from receipts where id_bin is null or lower(hex(id_bin)) <> lower(replace(id, '-', '')))
+     or exists (select 1 from receipts where user_id_bin is null or lower(hex(user_id_bin)) <> lower(replace(user_id, '-', '')))
+     or exists (select 1 from receipt_items where id_bin is null or lower(hex(id_bin)) <> lower(replace(id, '-', '')))
+     or exists (select 1 from receipt_items where receipt_id_bin is null or lower(hex(receipt_id_bin)) <> lower(replace(receipt_id, '-', '')))
+     or exists (select 1 from budgets where id_bin is null or lower(hex(id_bin)) <> lower(replace(id, '-', '')))
+     or exists (select 1 from budgets where user_id_bin is null or lower(hex(user_id_bin)) <> lower(replace(user_id, '-', '')))
+     or exists (select 1 from change_sequences where user_id_bin is null or lower(hex(user_id_bin)) <> lower(replace(user_id, '-', ''))) then
+    signal sqlstate '45000' set message_text = 'Converted ids do not match, text ids are kept';
+  end if;
+end//
+DELIMITER ;
+
+alter table categories drop foreign key fk_user_category;
+alter table receipts drop foreign key fk_user_receipt;
+alter table receipt_items drop foreign key fk_receipt_item;
+alter table budgets drop foreign key fk_user_budget;
+
+alter table users
+drop primary key,
+drop column id,
+change column id_bin id binary(16) not null first,
+add primary key (id);
+
+alter table categories
+drop primary key,
+drop index ix_user_id,
+drop index ix_user_id_change_seq,
+drop column id,
+drop column user_id,
+change column id_bin id binary(16) not null first,
+change column user_id_bin user_id binary(16) after id,
+add primary key (id),
+add index ix_user_id (user_id),
+add index ix_user_id_change_seq (user_id, change_seq);
+
+alter table receipts
+drop primary key,
+drop index ix_user_id,
+drop index ix_user_id_is_deleted_date,
+drop index ix_user_id_change_seq,
+drop column id,
+drop column user_id,
+change column id_bin id binary(16) not null first,
+change column user_id_bin user_id binary(16) not null after id,
+add primary key (id),
+add index ix_user_id (user_id),
+add index ix_user_id_is_deleted_date (user_id, is_deleted, `date`),
+add index ix_user_id_change_seq (user_id, change_seq);
+
+alter table receipt_items
+drop primary key,
+drop index ix_receipt_id,
+drop index ix_receipt_id_sort_order,
+drop column id,
+drop column receipt_id,
+change column id_bin id binary(16) not null first,
+change column receipt_id_bin receipt_id binary(16) not null after id,
+add primary key (id),
+add index ix_receipt_id (receipt_id),
+add unique index ix_receipt_id_sort_order (receipt_id, sort_order);
+
+alter table budgets
+drop primary key,
+drop index ix_user_id_month,
+drop index ix_user_id,
+drop index ix_user_id_change_seq,
+drop column id,
+drop column user_id,
+change column id_bin id binary(16) not null first,
+change column user_id_bin user_id binary(16) not null after id,
+add primary key (id),
+add unique index ix_user_id_month (user_id, month),
+add index ix_user_id (user_id),
+add index ix_user_id_change_seq (user_id, change_seq);
+
+alter table change_sequences
+drop primary key,
+drop column user_id,
+change column user_id_bin user_id binary(16) not null first,
+add primary key (user_id);
+
+alter table categories
+add constraint fk_user_category foreign key (user_id)
+  references users(id)
+  on delete cascade
+  on update restrict;
+
+alter table receipts
+add constraint fk_user_receipt foreign key (user_id)
+  references users(id)
+  on delete restrict
+  on update restrict;
+
+alter table receipt_items
+add constraint fk_receipt_item foreign key (receipt_id)
+  references receipts(id)
+  on delete cascade
+  on update restrict;
+
+alter table budgets
+add constraint fk_user_budget foreign key (user_id)
+  references users(id)
+  on delete restrict
+  on update restrict;
@@ -5,6 +5,7 @@
 #pragma once
 
 #include <memory>
+#include <tuple>
 #include "service_factory.hpp"
 #include "transient.hpp"
 #include "singleton.hpp"
@@ -49,6 +50,13 @@ class container {
   using _tuple = std::tuple<TServices...>;
   _tuple m_services;
 
+  template<typename TService>
+  static void release(TService &service) {
+    if constexpr (requires { service.release(); }) {
+      service.release();
+    }
+  }
+
   template<typename TInterface>
   static constexpr auto &
   get_service(_tuple &_t) noexcept
@@ -56,6 +64,25 @@ class container {
 
 
  public:
+  // Releases instances of scoped services when it ends, so that one container can serve
+  // many invocations while each of them starts with fresh scoped services.
+  class scope {
+   public:
+    explicit scope(container &c) : m_container(c) {}
+    scope(const scope &) = delete;
+    scope &operator=(const scope &) = delete;
+    ~scope() { m_container.release_scoped(); }
+
+   private:
+    container &m_container;
+  };
+
+  [[nodiscard]] scope begin_scope() { return scope(*this); }
+
+  void release_scoped() {
+    std::apply([](auto &...services) { (release(services), ...); }, m_services);
+  }
+
   template<typename T>
   auto get() {
     auto &service = get_service<typename std::decay<T>::type>(m_services);
@@ -30,6 +30,10 @@ struct scoped {
     return std::static_pointer_cast<type>(m_instance);
   }
 
+  void release() {
+    m_instance = nullptr;
+  }
+
  private:
   ptr<void> m_instance = nullptr;
 };
@@ -194,3 +194,20 @@ TEST(di_test, transient_dependency_should_be_unique) {
   EXPECT_EQ(b1->get_a_x(), 1);
   EXPECT_EQ(b2->get_a_x(), 2);
 }
+
+TEST(di_test, scoped_should_be_released_when_scope_ends) {
+  di::container<
+      di::singleton<i_a, a>,
+      di::scoped<a>
+  > container;
+
+  container.get<i_a>()->x = 1;
+  {
+    auto scope = container.begin_scope();
+    container.get<a>()->x = 123;
+    EXPECT_EQ(container.get<a>()->x, 123);
+  }
+
+  EXPECT_EQ(container.get<a>()->x, 0);
+  EXPECT_EQ(container.get<i_a>()->x, 1);
+}
@@ -0,0 +1,61 @@
+//
+// Created by Daniil Ryzhkov on 17/10/2026.
+//
+
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+
+#include "gtest/gtest.h"
+#include "lambda/log.hpp"
+
+namespace benchmark {
+
+// Mean time of one iteration, and the work done by all iterations, e.g. rows read or responses returned.
+struct measurement {
+  double per_iteration = 0;
+  size_t work = 0;
+};
+
+// Calls f iterations times, f returns the amount of work it did.
+// Time is reported in units of TPeriod, e.g. std::micro.
+template<typename TPeriod, typename F>
+measurement measure(size_t iterations, F &&f) {
+  size_t work = 0;
+  auto start = std::chrono::steady_clock::now();
+  for (size_t i = 0; i < iterations; i++) {
+    work += f();
+  }
+  auto elapsed = std::chrono::duration<double, TPeriod>(std::chrono::steady_clock::now() - start);
+  return {elapsed.count() / (double) iterations, work};
+}
+
+// Same as above, but every iteration first calls prepare outside of the measured time, and f takes its result.
+template<typename TPeriod, typename TPrepare, typename F>
+measurement measure(size_t iterations, TPrepare &&prepare, F &&f) {
+  size_t work = 0;
+  std::chrono::duration<double, TPeriod> elapsed{};
+  for (size_t i = 0; i < iterations; i++) {
+    auto input = prepare();
+    auto start = std::chrono::steady_clock::now();
+    work += f(input);
+    elapsed += std::chrono::steady_clock::now() - start;
+  }
+  return {elapsed.count() / (double) iterations, work};
+}
+
+// Expects the fast path to do the same work as the baseline, otherwise the ratio compares different things.
+inline void compare(const char *name, const char *unit, const measurement &baseline, const measurement &fast) {
+  EXPECT_EQ(fast.work, baseline.work) << name;
+  lambda::log.info("%s: %.1f %s vs %.1f %s, %.1fx",
+                   name, baseline.per_iteration, unit, fast.per_iteration, unit,
+                   baseline.per_iteration / fast.per_iteration);
+}
+
+// Logs a measurement without a baseline, e.g. when the baseline is too slow to run.
+inline void report(const char *name, const char *unit, const measurement &m) {
+  lambda::log.info("%s: %.1f %s", name, m.per_iteration, unit);
+}
+
+}
@@ -12,7 +12,7 @@
 
 #include "lambda/log.hpp"
 
-#define DEFAULT_USER_ID "user_id"
+#define DEFAULT_USER_ID "f47ac10b-58cc-4372-a567-0e02b2c3d479"
 
 class repository_integration_test : public ::testing::Test {
  protected:
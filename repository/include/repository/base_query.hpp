@@ -5,27 +5,47 @@
 #pragma once
 
 #include <memory>
+#include <string>
+#include <string_view>
+#include <vector>
 
 #include <mariadb/conncpp/PreparedStatement.hpp>
+#include <mariadb/conncpp/ResultSet.hpp>
+
+#include "models/guid.hpp"
+#include "models/money.hpp"
+#include "query_metrics.hpp"
 
 namespace repository {
 
 class base_query {
  public:
-  explicit base_query(std::shared_ptr<sql::PreparedStatement> stmt);
+  explicit base_query(std::shared_ptr<sql::PreparedStatement> stmt,
+                      query_metrics *metrics = nullptr,
+                      std::string_view query = {});
 
   void set_param(int t);
   void set_param(double t);
   void set_param(long t);
   void set_param(const std::string &t);
-  void set_param(long double t);
+  void set_param(const models::money &t);
+  void set_param(const models::guid &t);
 
  protected:
   std::shared_ptr<sql::PreparedStatement> get_stmt();
 
+  // Executes the query, recording its duration in metrics of the client.
+  std::unique_ptr<sql::ResultSet> execute_query();
+  void execute();
+
+  void record_rows(size_t rows);
+
  private:
   int m_param_index = 1;
   std::shared_ptr<sql::PreparedStatement> m_stmt;
+  query_metrics *m_metrics;
+  std::string m_query;
+  std::vector<parameter_shape> m_parameters;
 };
 
 }
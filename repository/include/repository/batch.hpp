@@ -0,0 +1,56 @@
+//
+// Created by Daniil Ryzhkov on 17/10/2026.
+//
+
+#pragma once
+
+#include <functional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include <mariadb/conncpp/PreparedStatement.hpp>
+
+#include "configurations/repository_configuration.hpp"
+
+namespace repository {
+
+// Group of parameterized statements sent to the server as one multi-statement query.
+// Parameters are bound to the most recently added statement.
+class batch {
+ public:
+  batch &add(std::string_view query);
+
+  // Adds upsert of the entity, which must outlive execution of the batch.
+  template<typename T>
+  batch &add_upsert(const T &entity) {
+    using configuration = configurations::repository_configuration<T>;
+    add(configuration::get_upsert_query());
+    m_binders.emplace_back([&entity](sql::PreparedStatement &stmt, int32_t index) {
+      return configuration::bind_upsert(index, entity, stmt);
+    });
+    return *this;
+  }
+
+  batch &with_param(int t);
+  batch &with_param(double t);
+  batch &with_param(long t);
+  batch &with_param(const std::string &t);
+  batch &with_param(const models::money &t);
+  batch &with_param(const models::guid &t);
+
+  [[nodiscard]] size_t size() const { return m_size; }
+  [[nodiscard]] bool empty() const { return m_size == 0; }
+  [[nodiscard]] const std::string &get_query() const { return m_query; }
+
+  void bind(sql::PreparedStatement &stmt) const;
+
+ private:
+  typedef std::function<int32_t(sql::PreparedStatement &, int32_t)> binder_t;
+
+  std::string m_query;
+  size_t m_size = 0;
+  std::vector<binder_t> m_binders;
+};
+
+}
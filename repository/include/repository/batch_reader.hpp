@@ -0,0 +1,69 @@
+//
+// Created by Daniil Ryzhkov on 17/10/2026.
+//
+
+#pragma once
+
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include <mariadb/conncpp/PreparedStatement.hpp>
+#include <mariadb/conncpp/ResultSet.hpp>
+
+#include "configurations/repository_configuration.hpp"
+#include "query_metrics.hpp"
+
+namespace repository {
+
+// Reads result sets of an executed multi-statement query in order of the statements.
+// Statements without result set, e.g. set of a variable, are skipped.
+class batch_reader {
+ public:
+  // Rows read are recorded in the metrics under the query of the batch, the metrics must outlive the reader.
+  batch_reader(std::shared_ptr<sql::PreparedStatement> stmt,
+               bool has_result_set,
+               query_metrics &metrics,
+               std::string query)
+      : m_stmt(std::move(stmt)), m_has_result_set(has_result_set), m_metrics(&metrics), m_query(std::move(query)) {}
+
+  // Reads all rows of the next result set into entities.
+  template<typename T>
+  std::vector<T> next() {
+    std::unique_ptr<sql::ResultSet> result(advance());
+    std::vector<T> output;
+    if (result->next()) {
+      configurations::repository_configuration<T> configuration;
+      auto plan = configuration.get_column_plan(result.get());
+      do {
+        configuration.read_entity(result.get(), plan, output.emplace_back());
+      } while (result->next());
+    }
+    m_metrics->record_rows(m_query, output.size());
+    return output;
+  }
+
+ private:
+  std::shared_ptr<sql::PreparedStatement> m_stmt;
+  bool m_has_result_set;
+  bool m_started = false;
+  query_metrics *m_metrics;
+  std::string m_query;
+
+  sql::ResultSet *advance() {
+    if (m_started) {
+      m_has_result_set = m_stmt->getMoreResults();
+    }
+    m_started = true;
+    while (!m_has_result_set) {
+      if (m_stmt->getUpdateCount() == -1) {
+        throw std::runtime_error("Batch has no more result sets!");
+      }
+      m_has_result_set = m_stmt->getMoreResults();
+    }
+    return m_stmt->getResultSet();
+  }
+};
+
+}
@@ -15,36 +15,19 @@ class category_repository {
  public:
   explicit category_repository(TRepository repository) : m_repository(std::move(repository)) {}
 
-  [[nodiscard]] std::vector<models::category> get_all(const std::string &user_id) const {
-    auto res = m_repository->template select<models::category>(
+  [[nodiscard]] std::vector<models::category> get_all(const models::guid &user_id) const {
+    return m_repository->template select<models::category>(
             "select * from categories where user_id = ? and is_deleted = 0 order by name")
         .with_param(user_id)
-        .all();
-    std::vector<models::category> results;
-    for (auto &category : *res) {
-      results.push_back(*category);
-    }
-    return results;
+        .to_vector();
   }
 
   void store(const models::category &category) {
-    auto existing_category = m_repository->template select<models::category>(
-            "select * from categories where id = ?")
-        .with_param(category.id)
-        .first_or_default();
-
-    if (!existing_category) {
-      m_repository->template create(category);
-    } else {
-      if (existing_category->is_deleted) {
-        throw concurrency_exception();
-      }
-      m_repository->template update(category);
-    }
+    m_repository->template upsert(category);
   }
 
   void drop(const models::guid &category_id) {
-    auto existing_category = m_repository->template get<models::category>(category_id);
+    auto existing_category = m_repository->template get<models::category>(category_id, read_route::primary);
 
     if (!existing_category) {
       throw entity_not_found_exception();
@@ -55,20 +38,14 @@ class category_repository {
     m_repository->template update(*existing_category);
   }
 
-  std::vector<models::category> get_changed(const models::guid &user_id, const std::string &since) {
-    auto categories = m_repository->template select<models::category>(
-            "select * from categories where user_id = ? and modified_timestamp > ?")
+  // Returns at most limit categories changed after the change sequence, in order of their changes.
+  std::vector<models::category> get_changed(const models::guid &user_id, long after, int limit) {
+    return m_repository->template select<models::category>(
+            "select * from categories where user_id = ? and change_seq > ? order by change_seq limit ?")
         .with_param(user_id)
-        .with_param(since)
-        .all();
-
-    std::vector<models::category> result;
-    result.reserve(categories->size());
-    for (const auto &c : *categories) {
-      result.push_back(*c);
-    }
-
-    return result;
+        .with_param(after)
+        .with_param(limit)
+        .to_vector();
   }
 
  private:
@@ -1,86 +1,156 @@
 #pragma once
 
+#include <future>
 #include <iostream>
 #include <map>
 #include <memory>
+#include <span>
 #include <string>
 
 #include <mariadb/conncpp/Connection.hpp>
 #include <mariadb/conncpp/PreparedStatement.hpp>
 #include <mariadb/conncpp/DriverManager.hpp>
+#include <mariadb/conncpp/Exception.hpp>
 
 #include <lambda/log.hpp>
 
 #include <aws/core/client/ClientConfiguration.h>
 
 #include "repository/configurations/registry.hpp"
+#include "batch.hpp"
+#include "batch_reader.hpp"
 #include "selector.hpp"
 #include "statement.hpp"
+#include "transaction.hpp"
 #include "connection_settings.hpp"
+#include "connection_pool.hpp"
 #include "exceptions.hpp"
+#include "query_metrics.hpp"
 
 namespace repository {
 
 std::string get_connection_string(const std::string &stage, const Aws::Client::ClientConfiguration &config);
+std::string get_replica_connection_string(const std::string &stage, const Aws::Client::ClientConfiguration &config);
+std::chrono::milliseconds get_replica_lag();
+size_t get_pool_size();
+std::chrono::milliseconds get_validation_interval();
+size_t get_statement_cache_size();
+std::chrono::milliseconds get_slow_query_threshold();
 
 struct t_client {};
 
+// Connection a read is served by.
+enum class read_route {
+  // read replica, unless the client is in a transaction or has written recently
+  replica,
+  // primary, for reads followed by writes based on them and reads of entities that may have just been written
+  primary,
+};
+
 template<
-    typename TSettings = const connection_settings>
+    typename TPool = connection_pool,
+    typename TReplicaPool = replica_pool>
 class client {
  public:
-  explicit client(TSettings settings) {
-    try {
-      lambda::log.info("Establishing connection with the database...");
-      m_settings = settings;
-      m_connection = std::move(create_connection());
-    } catch (std::exception &e) {
-      lambda::log.error(
-          "Error occurred while establishing connection with the database: %s",
-          e.what());
-      throw;
-    }
-  }
+  static constexpr auto METRICS_NAMESPACE = "ReceiptScan/Database";
 
-  ~client() {
-    if (m_connection) {
-      lambda::log.info("Closing connection with the database...");
-      m_connection->close();
-    }
+  client(TPool pool, TReplicaPool replica_pool)
+      : m_pool(std::move(pool)),
+        m_metrics(m_pool->get_slow_query_threshold()),
+        m_replica_pool(std::move(replica_pool)) {
+    m_lease = m_pool->acquire();
+    m_reported_reconnects = get_reconnects();
   }
 
   template<typename T>
   void create(const T &entity) {
     auto &configuration = m_registry.get<T>();
-    lambda::log.info("Inserting in %s...", configuration.get_table_name().c_str());
+    lambda::log.info("Inserting in %s...", configuration.get_table_name());
     try {
-      auto &stmt = configuration.get_insert_statement(entity, get_connection());
+      auto query = configuration.get_insert_query();
+      stopwatch timer;
+      mark_written();
+      auto stmt = configuration.get_insert_statement(entity, get_lease());
+      m_metrics.record_prepare(query, timer.elapsed());
       if (!stmt) {
         throw std::runtime_error("Unable to create prepared statement!");
       }
-      stmt->executeUpdate();
+      execute_update(query, *stmt);
     } catch (std::exception &e) {
+      on_error(e);
       lambda::log.error("Error occurred while creating entity in the database: %s",
                         e.what());
       throw;
     }
   }
 
+  // Inserts entities with multi-row insert statements, each kept within max_allowed_packet.
+  template<typename T>
+  void create_many(std::span<const T> entities) {
+    if (entities.empty()) {
+      return;
+    }
+
+    auto &configuration = m_registry.get<T>();
+    lambda::log.info("Inserting %zu rows in %s...", entities.size(), configuration.get_table_name());
+    try {
+      mark_written();
+      auto &lease = get_lease();
+      auto max_packet_size = lease.get_max_allowed_packet();
+      auto prefix_size = configuration.get_insert_prefix_size();
+
+      size_t begin = 0;
+      while (begin < entities.size()) {
+        size_t end = begin + 1;
+        size_t packet_size = prefix_size + configuration.get_insert_size(entities[begin]);
+        while (end < entities.size()) {
+          auto row_size = configuration.get_insert_size(entities[end]);
+          if (packet_size + row_size > max_packet_size) break;
+          packet_size += row_size;
+          end++;
+        }
+
+        // statements differ by number of rows, so they are recorded together under the prefix
+        auto query = configuration.get_insert_prefix();
+        stopwatch timer;
+        auto stmt = configuration.get_insert_many_statement(entities.subspan(begin, end - begin), lease);
+        m_metrics.record_prepare(query, timer.elapsed());
+        if (!stmt) {
+          throw std::runtime_error("Unable to create prepared statement!");
+        }
+        execute_update(query, *stmt);
+        begin = end;
+      }
+    } catch (std::exception &e) {
+      on_error(e);
+      lambda::log.error("Error occurred while creating entities in the database: %s",
+                        e.what());
+      throw;
+    }
+  }
+
   template<typename T>
-  std::shared_ptr<T> get(const models::guid &id) {
+  std::shared_ptr<T> get(const models::guid &id, read_route route = read_route::replica) {
     auto &configuration = m_registry.get<T>();
-    lambda::log.info("Getting entity from %s...", configuration.get_table_name().c_str());
+    lambda::log.info("Getting entity from %s...", configuration.get_table_name());
     try {
-      auto &stmt = configuration.get_select_statement(id, get_connection());
+      auto query = configuration.get_select_query();
+      stopwatch timer;
+      auto stmt = configuration.get_select_statement(id, get_read_lease(route));
+      m_metrics.record_prepare(query, timer.elapsed());
       if (!stmt) {
         throw std::runtime_error("Unable to create prepared statement!");
       }
+      timer = {};
       std::unique_ptr<sql::ResultSet> result(stmt->executeQuery());
+      m_metrics.record_execute(query, timer.elapsed());
       if (result->next()) {
+        m_metrics.record_rows(query, 1);
         return std::move(configuration.get_entity(result.get()));
       }
       throw entity_not_found_exception();
     } catch (std::exception &e) {
+      on_error(e);
       lambda::log.error(
           "Error occurred while getting entity from the database: %s", e.what());
       throw;
@@ -90,38 +160,76 @@ class client {
   template<typename T>
   void update(const T &entity) {
     auto &configuration = m_registry.get<T>();
-    lambda::log.info("Updating in %s...", configuration.get_table_name().c_str());
+    lambda::log.info("Updating in %s...", configuration.get_table_name());
     try {
-      auto &stmt = configuration.get_update_statement(entity, get_connection());
+      auto query = configuration.get_update_query();
+      stopwatch timer;
+      mark_written();
+      auto stmt = configuration.get_update_statement(entity, get_lease());
+      m_metrics.record_prepare(query, timer.elapsed());
       if (!stmt) {
         throw std::runtime_error("Unable to create prepared statement!");
       }
-      auto result = stmt->executeUpdate();
+      auto result = execute_update(query, *stmt);
       if (result == 0) {
         throw concurrency_exception();
       }
     } catch (std::exception &e) {
+      on_error(e);
       lambda::log.error("Error occurred while updating entity in the database: %s",
                         e.what());
       throw;
     }
   }
 
+  // Creates or updates the entity in one statement. Stored entity is kept and concurrency
+  // exception is thrown if its version is not older or it has been deleted.
+  template<typename T>
+  void upsert(const T &entity) {
+    auto &configuration = m_registry.get<T>();
+    lambda::log.info("Upserting in %s...", configuration.get_table_name());
+    try {
+      auto query = configuration.get_upsert_query();
+      stopwatch timer;
+      mark_written();
+      auto stmt = configuration.get_upsert_statement(entity, get_lease());
+      m_metrics.record_prepare(query, timer.elapsed());
+      if (!stmt) {
+        throw std::runtime_error("Unable to create prepared statement!");
+      }
+      // 1 if inserted, 2 if updated, 0 if stored row is kept
+      auto result = execute_update(query, *stmt);
+      if (result == 0) {
+        throw concurrency_exception();
+      }
+    } catch (std::exception &e) {
+      on_error(e);
+      lambda::log.error("Error occurred while upserting entity in the database: %s",
+                        e.what());
+      throw;
+    }
+  }
+
   template<typename T>
   void drop(const T &entity) {
     auto &configuration = m_registry.get<T>();
-    lambda::log.info("Deleting from %s...", configuration.get_table_name().c_str());
+    lambda::log.info("Deleting from %s...", configuration.get_table_name());
     try {
-      auto &stmt = configuration.get_delete_statement(entity, get_connection());
+      auto query = configuration.get_delete_query();
+      stopwatch timer;
+      mark_written();
+      auto stmt = configuration.get_delete_statement(entity, get_lease());
+      m_metrics.record_prepare(query, timer.elapsed());
       if (!stmt) {
         throw std::runtime_error("Unable to create prepared statement!");
       }
 
-      auto result = stmt->executeUpdate();
+      auto result = execute_update(query, *stmt);
       if (result == 0) {
         throw concurrency_exception();
       }
     } catch (std::exception &e) {
+      on_error(e);
       lambda::log.error("Error occurred while deleting entity in the database: %s",
                         e.what());
       throw;
@@ -129,17 +237,17 @@ class client {
   }
 
   template<typename T>
-  selector<T> select(const std::string &query) {
+  selector<T> select(const std::string &query, read_route route = read_route::replica) {
     auto &configuration = m_registry.get<T>();
     lambda::log.info("Executing query: %s", query.c_str());
     try {
-      std::shared_ptr<sql::PreparedStatement> stmt(get_connection()->prepareStatement(query));
-      stmt->closeOnCompletion();
+      auto stmt = prepare(query, get_read_lease(route));
       if (!stmt) {
         throw std::runtime_error("Unable to create prepared statement!");
       }
-      return selector<T>(stmt, configuration);
+      return selector<T>(stmt, configuration, &m_metrics, query);
     } catch (std::exception &e) {
+      on_error(e);
       lambda::log.error(
           "Error occurred while preparing query: %s",
           e.what());
@@ -150,13 +258,14 @@ class client {
   statement execute(const std::string &query) {
     lambda::log.info("Executing query: %s", query.c_str());
     try {
-      std::shared_ptr<sql::PreparedStatement> stmt(get_connection()->prepareStatement(query));
-      stmt->closeOnCompletion();
+      mark_written();
+      auto stmt = prepare(query, get_lease());
       if (!stmt) {
         throw std::runtime_error("Unable to create prepared statement!");
       }
-      return statement(stmt);
+      return statement(stmt, &m_metrics, query);
     } catch (std::exception &e) {
+      on_error(e);
       lambda::log.error(
           "Error occurred while preparing query: %s",
           e.what());
@@ -164,35 +273,254 @@ class client {
     }
   }
 
-  std::shared_ptr<sql::Connection> get_connection() {
-    if (!m_connection || m_connection->isClosed() || !m_connection->isValid()) {
-      std::string prev_schema;
-      if (m_connection) {
-        prev_schema = m_connection->getSchema();
+  // Sends all statements of the batch in one round trip and returns rows affected by each of them.
+  std::vector<int64_t> execute_batch(const batch &statements) {
+    if (statements.empty()) {
+      return {};
+    }
+
+    lambda::log.info("Executing batch of %zu statements: %s", statements.size(), statements.get_query().c_str());
+    try {
+      mark_written();
+      const auto &query = statements.get_query();
+      auto stmt = prepare(query, get_lease());
+      if (!stmt) {
+        throw std::runtime_error("Unable to create prepared statement!");
       }
-      lambda::log.info("Reconnecting to the database...");
-      m_connection = std::move(create_connection());
-      if (!prev_schema.empty()) {
-        m_connection->setSchema(prev_schema);
+      statements.bind(*stmt);
+
+      std::vector<int64_t> affected_rows;
+      affected_rows.reserve(statements.size());
+      stopwatch timer;
+      auto has_result_set = stmt->execute();
+      while (true) {
+        if (has_result_set) {
+          throw std::runtime_error("Batch must not contain queries returning result set!");
+        }
+        auto count = stmt->getUpdateCount();
+        if (count == -1) {
+          break;
+        }
+        affected_rows.push_back(count);
+        has_result_set = stmt->getMoreResults();
       }
+      m_metrics.record_execute(query, timer.elapsed());
+      if (affected_rows.size() != statements.size()) {
+        throw std::runtime_error("Unexpected number of batch results!");
+      }
+      int64_t rows = 0;
+      for (auto count : affected_rows) rows += count;
+      m_metrics.record_rows(query, rows);
+      return affected_rows;
+    } catch (std::exception &e) {
+      on_error(e);
+      lambda::log.error("Error occurred while executing batch: %s", e.what());
+      throw;
     }
-    return m_connection;
+  }
+
+  // Sends all statements of the batch in one round trip and returns reader of their result sets.
+  batch_reader query_batch(const batch &statements, read_route route = read_route::replica) {
+    lambda::log.info("Executing batch of %zu queries: %s", statements.size(), statements.get_query().c_str());
+    try {
+      const auto &query = statements.get_query();
+      auto stmt = prepare(query, get_read_lease(route));
+      if (!stmt) {
+        throw std::runtime_error("Unable to create prepared statement!");
+      }
+      statements.bind(*stmt);
+      // result sets are streamed by the reader, so only the first one is timed
+      stopwatch timer;
+      auto has_result_set = stmt->execute();
+      m_metrics.record_execute(query, timer.elapsed());
+      return {stmt, has_result_set, m_metrics, query};
+    } catch (std::exception &e) {
+      on_error(e);
+      lambda::log.error("Error occurred while executing batch: %s", e.what());
+      throw;
+    }
+  }
+
+  // Begins transaction on the connection of the client, or a savepoint if one is already active.
+  // Usage:
+  //   auto transaction = client->transaction();
+  //   ...
+  //   transaction.commit();
+  repository::transaction transaction() {
+    try {
+      return {get_lease().get(), m_transaction};
+    } catch (std::exception &e) {
+      on_error(e);
+      lambda::log.error("Error occurred while beginning transaction: %s", e.what());
+      throw;
+    }
+  }
+
+  std::shared_ptr<sql::Connection> get_connection() {
+    return get_lease().get();
+  }
+
+  [[nodiscard]] statement_cache_stats get_statement_cache_stats() const {
+    return m_lease.get_statement_cache_stats();
+  }
+
+  [[nodiscard]] const transaction_stats &get_transaction_stats() const {
+    return m_transaction.stats;
+  }
+
+  // Runs independent queries concurrently and returns tuple of their results. Each query is a callable
+  // taking client to run on. The first one runs on this client in the calling thread, the others on
+  // connections the pool reads are routed to has to spare, or on this client after the first one if it has none.
+  // Queries run one after another on this client inside a transaction, to see its changes.
+  // Usage:
+  //   auto [receipts, items] = client->fan_out(
+  //       [&](auto &c) { return c.template select<receipt>(...).to_vector(); },
+  //       [&](auto &c) { return c.template select<receipt_item>(...).to_vector(); });
+  template<typename TFirst, typename... TRest>
+  auto fan_out(TFirst &&first, TRest &&...rest) {
+    if (m_transaction.depth > 0) {
+      // braced initialization runs the queries in order
+      return std::tuple<std::invoke_result_t<TFirst, client &>, std::invoke_result_t<TRest, client &>...>{
+          first(*this), rest(*this)...};
+    }
+
+    auto others = std::make_tuple(start(std::forward<TRest>(rest))...);
+    auto first_result = first(*this);
+    return std::apply([&](auto &...other) {
+      return std::tuple<std::invoke_result_t<TFirst, client &>, std::invoke_result_t<TRest, client &>...>{
+          std::move(first_result), join(other)...};
+    }, others);
+  }
+
+  [[nodiscard]] const query_metrics &get_query_metrics() const {
+    return m_metrics;
+  }
+
+  // Writes metrics of queries executed since the last flush to stdout as CloudWatch embedded
+  // metric format lines, attributing totals to the user. Called at the end of each invocation.
+  void flush_metrics(std::string_view user_id = {}) {
+    auto reconnects = get_reconnects();
+    m_metrics.record_reconnects(reconnects - m_reported_reconnects);
+    m_reported_reconnects = reconnects;
+    if (m_metrics.empty()) {
+      return;
+    }
+
+    for (const auto &line : m_metrics.to_emf(METRICS_NAMESPACE, user_id, std::chrono::system_clock::now())) {
+      std::cout << line << '\n';
+    }
+    std::cout.flush();
+    m_metrics.reset();
   }
 
  private:
-  std::shared_ptr<sql::Connection> m_connection;
-  TSettings m_settings;
+  TPool m_pool;
+  connection_lease m_lease;
   configurations::registry m_registry;
+  transaction_context m_transaction;
+  query_metrics m_metrics;
+  size_t m_reported_reconnects = 0;
+
+  TReplicaPool m_replica_pool;
+  connection_lease m_replica_lease;
+  // reads are served by the primary until then, to see the latest writes despite replica lag
+  std::chrono::steady_clock::time_point m_primary_until;
+
+  // Client of a concurrent query, routing reads the same way as the client it is started by.
+  client(const client &parent, connection_lease lease, bool is_replica)
+      : m_pool(parent.m_pool),
+        m_metrics(m_pool->get_slow_query_threshold()),
+        m_replica_pool(parent.m_replica_pool),
+        m_primary_until(parent.m_primary_until) {
+    (is_replica ? m_replica_lease : m_lease) = std::move(lease);
+  }
+
+  // Starts query on a spare connection, or defers it to the calling thread if there is none.
+  // Metrics of the query are returned with its result, to be merged after it is joined.
+  template<typename TQuery>
+  auto start(TQuery &&query) {
+    using result_t = std::pair<std::invoke_result_t<TQuery, client &>, query_metrics>;
+    auto is_replica = reads_from_replica(read_route::replica);
+    auto lease = is_replica ? m_replica_pool->try_acquire() : m_pool->try_acquire();
+    if (!lease) {
+      return std::async(std::launch::deferred, [this, query = std::forward<TQuery>(query)]() mutable {
+        return result_t{query(*this), query_metrics()};
+      });
+    }
+    lambda::log.info("Running query concurrently on another connection...");
+    auto other = std::unique_ptr<client>(new client(*this, std::move(lease), is_replica));
+    return std::async(std::launch::async, [other = std::move(other), query = std::forward<TQuery>(query)]() mutable {
+      auto result = query(*other);
+      return result_t{std::move(result), std::move(other->m_metrics)};
+    });
+  }
+
+  template<typename TResult>
+  TResult join(std::future<std::pair<TResult, query_metrics>> &future) {
+    auto result = future.get();
+    m_metrics.merge(result.second);
+    return std::move(result.first);
+  }
+
+  connection_lease &get_lease() {
+    if (!m_lease) {
+      m_lease = m_pool->acquire();
+    }
+    return m_lease;
+  }
+
+  bool reads_from_replica(read_route route) const {
+    return route == read_route::replica &&
+        m_replica_pool && m_replica_pool->is_configured() &&
+        m_transaction.depth == 0 &&
+        std::chrono::steady_clock::now() >= m_primary_until;
+  }
+
+  connection_lease &get_read_lease(read_route route) {
+    if (!reads_from_replica(route)) {
+      return get_lease();
+    }
+    if (!m_replica_lease) {
+      m_replica_lease = m_replica_pool->acquire();
+    }
+    return m_replica_lease;
+  }
+
+  size_t get_reconnects() const {
+    auto reconnects = m_pool->get_reconnects();
+    if (m_replica_pool) {
+      reconnects += m_replica_pool->get_reconnects();
+    }
+    return reconnects;
+  }
+
+  void mark_written() {
+    if (m_replica_pool && m_replica_pool->is_configured()) {
+      m_primary_until = std::chrono::steady_clock::now() + m_replica_pool->get_lag();
+    }
+  }
+
+  std::shared_ptr<sql::PreparedStatement> prepare(std::string_view query, connection_lease &lease) {
+    stopwatch timer;
+    auto stmt = lease.prepare(query);
+    m_metrics.record_prepare(query, timer.elapsed());
+    return stmt;
+  }
+
+  int32_t execute_update(std::string_view query, sql::PreparedStatement &stmt) {
+    stopwatch timer;
+    auto result = stmt.executeUpdate();
+    m_metrics.record_execute(query, timer.elapsed());
+    m_metrics.record_rows(query, result);
+    return result;
+  }
 
-  std::unique_ptr<sql::Connection> create_connection() {
-    sql::SQLString url(m_settings->connection_string);
-    std::unique_ptr<sql::Connection> conn(sql::DriverManager::getConnection(url));
-    if (conn == nullptr) {
-      lambda::log.error("Unable to establish connection with database!");
-      throw std::runtime_error("Unable to establish connection with database!");
+  void on_error(const std::exception &e) {
+    // the connection is pinged again only if the failure came from the driver
+    if (dynamic_cast<const sql::SQLException *>(&e)) {
+      m_lease.invalidate();
+      m_replica_lease.invalidate();
     }
-    conn->prepareStatement("set time_zone = '+00:00'")->execute();
-    return std::move(conn);
   }
 };
 
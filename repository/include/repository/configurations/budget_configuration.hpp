@@ -10,21 +10,20 @@
 namespace repository {
 namespace configurations {
 
-template<>
-class repository_configuration<models::budget>
-    : public common::base_repository_configuration<models::budget> {
- public:
-  repository_configuration() {
-    HAS_TABLE("budgets");
+template <>
+struct entity_mapping<models::budget> {
+  static constexpr std::string_view table = "budgets";
 
-    HAS_ID(id) WITH_COLUMN("id");
+  static constexpr common::column id{"id", &models::budget::id};
 
-    HAS_STRING(user_id) WITH_COLUMN("user_id");
-    HAS_STRING(month) WITH_COLUMN("month");
-    HAS_DOUBLE(amount) WITH_COLUMN("amount");
+  static constexpr std::tuple properties{
+      common::column{"user_id", &models::budget::user_id},
+      common::column{"month", &models::budget::month},
+      common::column{"amount", &models::budget::amount},
+      common::column{"change_seq", &models::budget::change_seq}
+  };
 
-    HAS_VERSION();
-  }
+  static constexpr common::column version{"version", &models::budget::version};
 };
 
 }
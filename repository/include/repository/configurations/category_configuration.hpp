@@ -6,22 +6,23 @@
 namespace repository::configurations {
 
 template <>
-class repository_configuration<models::category>
-    : public common::base_repository_configuration<models::category> {
- public:
-  repository_configuration() : base_repository_configuration() {
-    HAS_TABLE("categories");
-
-    HAS_ID(id) WITH_COLUMN("id");
-
-    HAS_STRING(user_id) WITH_COLUMN("user_id");
-    HAS_STRING(name) WITH_COLUMN("name");
-    HAS_INT(color) WITH_COLUMN("color");
-    HAS_INT(icon) WITH_COLUMN("icon");
-    HAS_BOOL(is_deleted) WITH_COLUMN("is_deleted");
-
-    HAS_VERSION();
-  }
+struct entity_mapping<models::category> {
+  static constexpr std::string_view table = "categories";
+
+  static constexpr common::column id{"id", &models::category::id};
+
+  static constexpr std::tuple properties{
+      common::column{"user_id", &models::category::user_id},
+      common::column{"name", &models::category::name},
+      common::column{"color", &models::category::color},
+      common::column{"icon", &models::category::icon},
+      common::column{"is_deleted", &models::category::is_deleted},
+      common::column{"change_seq", &models::category::change_seq}
+  };
+
+  static constexpr common::column deleted{"is_deleted", &models::category::is_deleted};
+
+  static constexpr common::column version{"version", &models::category::version};
 };
 
 } // namespace repository::configurations
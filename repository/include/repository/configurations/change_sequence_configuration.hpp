@@ -0,0 +1,23 @@
+//
+// Created by Daniil Ryzhkov on 17/10/2026.
+//
+
+#pragma once
+
+#include "repository/models/change_sequence.hpp"
+#include "repository_configuration.hpp"
+
+namespace repository::configurations {
+
+template <>
+struct entity_mapping<models::change_sequence> {
+  static constexpr std::string_view table = "change_sequences";
+
+  static constexpr common::column id{"user_id", &models::change_sequence::user_id};
+
+  static constexpr std::tuple properties{
+      common::column{"seq", &models::change_sequence::seq}
+  };
+};
+
+}
@@ -1,306 +1,360 @@
 #pragma once
 
-#include <functional>
-#include <iostream>
+#include <array>
 #include <memory>
+#include <span>
 #include <string>
-#include <vector>
+#include <string_view>
+#include <tuple>
+#include <unordered_map>
 
 #include <mariadb/conncpp/Connection.hpp>
 #include <mariadb/conncpp/PreparedStatement.hpp>
+#include <mariadb/conncpp/ResultSetMetaData.hpp>
 
+#include <repository/connection_pool.hpp>
 #include <repository/models/common.hpp>
 
-#include "id_configuration.hpp"
-#include "property_configuration.hpp"
-#include "table_configuration.hpp"
-#include "version_configuration.hpp"
-
-#define HAS_TABLE(table_name) has_table(table_name)
-
-#define HAS_ID(id_field) \
-  has_id(                                                \
-      [](const entity_t& entity) -> const models::guid& { \
-        return entity.id_field;                          \
-      },                                                 \
-      [](entity_t& entity, const models::guid& id) {      \
-        entity.id_field = id;                            \
-      })
-
-#define HAS_STRING(field) \
-  has_property<std::string>(                             \
-      [](const entity_t& entity) -> const std::string& { \
-        return entity.field;                             \
-      },                                                 \
-      [](entity_t& entity, const std::string& s) { entity.field = s; })
-
-#define HAS_INT(field) \
-  has_property<int>(   \
-      [](const entity_t& entity) -> int { return entity.field; }, \
-      [](entity_t& entity, int i) { entity.field = i; })
-
-#define HAS_DOUBLE(field) \
-  has_property<double>(   \
-      [](const entity_t& entity) -> double { return entity.field; }, \
-      [](entity_t& entity, double d) { entity.field = d; })
-
-#define HAS_BOOL(field) \
-  has_property<bool>(   \
-      [](const entity_t& entity) -> bool { return entity.field; }, \
-      [](entity_t& entity, bool b) { entity.field = b; })
-
-#define HAS_DECIMAL(field) \
-  has_property<long double>( \
-      [](const entity_t& entity) -> long double { return entity.field; }, \
-      [](entity_t& entity, long double d) { entity.field = d; })
-
-#define HAS_VERSION() has_version([](const entity_t& entity) -> const int & { return entity.version; }, [](entity_t& entity, const int &v) { entity.version = v; }).with_column_name("version")
-
-#define WITH_COLUMN(column_name) .with_column_name(column_name)
+#include "column_configuration.hpp"
+#include "static_string.hpp"
 
 namespace repository::configurations::common {
 
-template<typename T>
+template<typename TMapping>
+concept versioned_mapping = requires { TMapping::version; };
+
+// Entity is deleted logically by the flag column, which is also listed in properties.
+template<typename TMapping>
+concept soft_deleted_mapping = requires { TMapping::deleted; };
+
+template<typename T, typename TMapping>
 class base_repository_configuration {
  public:
-  const std::shared_ptr<sql::PreparedStatement> &get_insert_statement(
-      const T &entity, const std::shared_ptr<sql::Connection> &connection) {
-    if (!m_insert_statement) {
-      if (!m_table) {
-        throw std::runtime_error("Table is not configured!");
-      }
-      if (!m_id) {
-        throw std::runtime_error("Id is not configured!");
-      }
+  static constexpr size_t property_count = std::tuple_size_v<std::remove_cvref_t<decltype(TMapping::properties)>>;
+  static constexpr bool has_version = versioned_mapping<TMapping>;
+  static constexpr bool has_deleted = soft_deleted_mapping<TMapping>;
+  static constexpr size_t column_count = property_count + 1 + (has_version ? 1 : 0);
+
+  // Result set ordinals of the mapped columns: id, properties, version.
+  typedef std::array<int32_t, column_count> column_plan;
+
+  std::shared_ptr<sql::PreparedStatement> get_insert_statement(
+      const T &entity, connection_lease &connection) const {
+    auto stmt = connection.prepare(insert_query.view());
+    configure_insert_statement(1, entity, *stmt);
+    return stmt;
+  }
 
-      std::string query =
-          "insert into " + m_table->get_name() + " (" + m_id->get_column_name();
-      for (const auto &property : m_properties) {
-        if (!property) continue;
-        query += ", " + property->get_column_name();
-      }
-      if (m_version) {
-        query += ", " + m_version->get_column_name();
-      }
-      query += ") values (?";
-      for (size_t i = 0; i < m_properties.size(); i++) {
-        query += ", ?";
-      }
-      if (m_version) {
-        query += ", ?";
-      }
-      query += ")";
-      std::shared_ptr<sql::PreparedStatement> stmt(
-          connection->prepareStatement(query));
-      if (!stmt) {
-        throw std::runtime_error("Unable to create prepared statement!");
-      }
-      m_insert_statement = std::move(stmt);
+  std::shared_ptr<sql::PreparedStatement> get_insert_many_statement(
+      std::span<const T> entities, connection_lease &connection) const {
+    if (entities.size() == 1) {
+      return get_insert_statement(entities.front(), connection);
     }
 
-    m_id->configure_statement(1, entity, m_insert_statement);
-    int property_index = 2;
-    for (size_t i = 0; i < m_properties.size(); i++) {
-      if (!m_properties[i]) continue;
-      m_properties[i]->configure_statement(property_index, entity,
-                                           m_insert_statement);
-      property_index++;
+    // queries differ by number of rows, caching them would evict the statements used on every request
+    std::string query(insert_prefix.view());
+    query.reserve(query.size() + entities.size() * (insert_row.size() + 2));
+    for (size_t i = 0; i < entities.size(); i++) {
+      if (i > 0) query += ", ";
+      query += insert_row.view();
     }
-    if (m_version) {
-      m_version->configure_statement(property_index, m_version->get_version(entity), m_insert_statement);
+
+    auto stmt = connection.prepare_uncached(query);
+    int32_t property_index = 1;
+    for (const auto &entity : entities) {
+      property_index = configure_insert_statement(property_index, entity, *stmt);
     }
+    return stmt;
+  }
 
-    return m_insert_statement;
+  // Inserts the entity or updates the stored one only if its version is older and it is not
+  // deleted logically. Rows affected are 0 when the stored entity is kept.
+  std::shared_ptr<sql::PreparedStatement> get_upsert_statement(
+      const T &entity, connection_lease &connection) const {
+    auto stmt = connection.prepare(get_upsert_query());
+    bind_upsert(1, entity, *stmt);
+    return stmt;
   }
 
-  const std::shared_ptr<sql::PreparedStatement> &get_select_statement(
-      const std::string &id,
-      const std::shared_ptr<sql::Connection> &connection) {
-    if (!m_select_statement) {
-      if (!m_table) {
-        throw std::runtime_error("Table is not configured!");
-      }
-      if (!m_id) {
-        throw std::runtime_error("Id is not configured!");
-      }
+  static constexpr std::string_view get_insert_query() {
+    return insert_query.view();
+  }
 
-      std::string query = "select " + m_id->get_column_name();
-      for (const auto &property : m_properties) {
-        if (!property) continue;
-        query += ", " + property->get_column_name();
-      }
-      if (m_version) {
-        query += ", " + m_version->get_column_name();
-      }
-      query += " from " + m_table->get_name() + " where " +
-          m_id->get_column_name() + " = ?";
-      std::shared_ptr<sql::PreparedStatement> stmt(
-          connection->prepareStatement(query));
-      if (!stmt) {
-        throw std::runtime_error("Unable to create prepared statement!");
-      }
-      m_select_statement = std::move(stmt);
-    }
+  // Prefix of multi-row insert queries, which differ by number of rows.
+  static constexpr std::string_view get_insert_prefix() {
+    return insert_prefix.view();
+  }
 
-    m_select_statement->setString(1, id);
+  static constexpr std::string_view get_upsert_query() {
+    static_assert(has_version, "Upsert requires versioned entity");
+    return upsert_query.view();
+  }
 
-    return m_select_statement;
+  // Binds parameters of upsert query starting at property_index, returns the next index.
+  static int32_t bind_upsert(int32_t property_index, const T &entity, sql::PreparedStatement &stmt) {
+    return configure_insert_statement(property_index, entity, stmt);
   }
 
-  std::shared_ptr<T> get_entity(sql::ResultSet *result) {
-    auto entity = std::make_shared<T>();
-    m_id->set_id(*entity, result);
-    for (size_t i = 0; i < m_properties.size(); i++) {
-      if (!m_properties[i]) continue;
-      m_properties[i]->set_entity_property(*entity, result);
-    }
-    if (m_version) {
-      m_version->set_version(*entity, result);
+  // Upper bound of bytes the entity row adds to the insert statement sent to the server.
+  size_t get_insert_size(const T &entity) const {
+    size_t size = insert_row.size() + 2 + get_size(entity.*TMapping::id.member);
+    std::apply([&](const auto &...property) {
+      ((size += get_size(entity.*property.member)), ...);
+    }, TMapping::properties);
+    if constexpr (has_version) {
+      size += MAX_NUMERIC_SIZE;
     }
-    return entity;
+    return size;
   }
 
-  const std::shared_ptr<sql::PreparedStatement> &get_update_statement(
-      const T &entity, const std::shared_ptr<sql::Connection> &connection) {
-    if (!m_update_statement) {
-      if (!m_table) {
-        throw std::runtime_error("Table is not configured!");
-      }
-      if (!m_id) {
-        throw std::runtime_error("Id is not configured!");
-      }
+  static constexpr size_t get_insert_prefix_size() {
+    return insert_prefix.size();
+  }
 
-      std::string query = "update " + m_table->get_name() + " set ";
-      for (size_t i = 0; i < m_properties.size(); i++) {
-        if (!m_properties[i]) continue;
-        query += m_properties[i]->get_column_name() + " = ?";
-        if (i < m_properties.size() - 1) {
-          query += ", ";
-        }
-      }
-      if (m_version) {
-        query += ", " + m_version->get_column_name() + " = ?";
-      }
-      query += " where " + m_id->get_column_name() + " = ?";
-      if (m_version) {
-        query += " and " + m_version->get_column_name() + " < ?";
-      }
-      std::shared_ptr<sql::PreparedStatement> stmt(
-          connection->prepareStatement(query));
-      if (!stmt) {
-        throw std::runtime_error("Unable to create prepared statement!");
-      }
-      m_update_statement = std::move(stmt);
-    }
+  std::shared_ptr<sql::PreparedStatement> get_select_statement(
+      const models::guid &id,
+      connection_lease &connection) const {
+    auto stmt = connection.prepare(select_query.view());
+    bind(*stmt, 1, id);
+    return stmt;
+  }
 
-    int property_index = 1;
-    int entity_version = 0;
-    for (size_t i = 0; i < m_properties.size(); i++) {
-      if (!m_properties[i]) continue;
-      m_properties[i]->configure_statement(property_index, entity, m_update_statement);
-      property_index++;
+  // Returns select list of the mapped columns of table alias, labeled with prefix,
+  // e.g. "ri.id as item_id, ri.description as item_description".
+  static std::string get_column_list(std::string_view alias, std::string_view prefix) {
+    std::string columns;
+    auto append = [&](std::string_view name) {
+      if (!columns.empty()) columns += ", ";
+      columns.append(alias).append(".").append(name).append(" as ").append(prefix).append(name);
+    };
+    append(TMapping::id.name);
+    std::apply([&](const auto &...property) {
+      (append(property.name), ...);
+    }, TMapping::properties);
+    if constexpr (has_version) {
+      append(TMapping::version.name);
     }
-    if (m_version) {
-      entity_version = m_version->get_version(entity);
-      m_version->configure_statement(property_index, entity_version, m_update_statement);
-      property_index++;
+    return columns;
+  }
+
+  // Resolves ordinals of the mapped columns in the result set.
+  // Columns are looked up by name with prefix, if any.
+  column_plan get_column_plan(sql::ResultSet *result, std::string_view prefix = {}) const {
+    std::unique_ptr<sql::ResultSetMetaData> metadata(result->getMetaData());
+    std::unordered_map<std::string, int32_t> ordinals;
+    auto count = static_cast<int32_t>(metadata->getColumnCount());
+    ordinals.reserve(count);
+    for (int32_t i = 1; i <= count; i++) {
+      // first column wins, same as lookup by name
+      auto label = metadata->getColumnLabel(i);
+      ordinals.emplace(std::string(label.c_str(), label.length()), i);
     }
-    m_id->configure_statement(property_index, entity, m_update_statement);
-    property_index++;
-    if (m_version) {
-      m_version->configure_statement(property_index, entity_version, m_update_statement);
+
+    auto find = [&ordinals, prefix](std::string_view column_name) {
+      auto label = std::string(prefix).append(column_name);
+      auto found = ordinals.find(label);
+      if (found == ordinals.end()) {
+        throw std::runtime_error("Column " + label + " is not found in result set!");
+      }
+      return found->second;
+    };
+
+    column_plan plan{};
+    size_t column = 0;
+    plan[column++] = find(TMapping::id.name);
+    std::apply([&](const auto &...property) {
+      ((plan[column++] = find(property.name)), ...);
+    }, TMapping::properties);
+    if constexpr (has_version) {
+      plan[column] = find(TMapping::version.name);
     }
+    return plan;
+  }
 
-    return m_update_statement;
+  std::shared_ptr<T> get_entity(sql::ResultSet *result) const {
+    return get_entity(result, get_column_plan(result));
   }
 
-  const std::shared_ptr<sql::PreparedStatement> &get_delete_statement(
-      const T &entity, const std::shared_ptr<sql::Connection> &connection) {
-    if (!m_delete_statement) {
-      if (!m_table) {
-        throw std::runtime_error("Table is not configured!");
-      }
-      if (!m_id) {
-        throw std::runtime_error("Id is not configured!");
-      }
+  std::shared_ptr<T> get_entity(sql::ResultSet *result, const column_plan &plan) const {
+    auto entity = std::make_shared<T>();
+    read_entity(result, plan, *entity);
+    return entity;
+  }
 
-      std::string query = "delete from " + m_table->get_name() + " where " +
-          m_id->get_column_name() + " = ?";
-      if (m_version) {
-        query += " and " + m_version->get_column_name() + " = ?";
-      }
-      std::shared_ptr<sql::PreparedStatement> stmt(
-          connection->prepareStatement(query));
-      if (!stmt) {
-        throw std::runtime_error("Unable to create prepared statement!");
-      }
-      m_delete_statement = std::move(stmt);
+  // Reads current row of the result set into existing entity.
+  void read_entity(sql::ResultSet *result, const column_plan &plan, T &entity) const {
+    size_t column = 0;
+    read(*result, plan[column++], entity.*TMapping::id.member);
+    std::apply([&](const auto &...property) {
+      (read(*result, plan[column++], entity.*property.member), ...);
+    }, TMapping::properties);
+    if constexpr (has_version) {
+      read(*result, plan[column], entity.*TMapping::version.member);
     }
+  }
 
-    m_id->configure_statement(1, entity, m_delete_statement);
-    if (m_version) {
-      m_version->configure_statement(2, m_version->get_version(entity), m_delete_statement);
+  std::shared_ptr<sql::PreparedStatement> get_update_statement(
+      const T &entity, connection_lease &connection) const {
+    auto stmt = connection.prepare(update_query.view());
+
+    int32_t property_index = 1;
+    std::apply([&](const auto &...property) {
+      (bind(*stmt, property_index++, entity.*property.member), ...);
+    }, TMapping::properties);
+    if constexpr (has_version) {
+      bind(*stmt, property_index++, entity.*TMapping::version.member);
+    }
+    bind(*stmt, property_index++, entity.*TMapping::id.member);
+    if constexpr (has_version) {
+      bind(*stmt, property_index, entity.*TMapping::version.member);
     }
 
-    return m_delete_statement;
+    return stmt;
   }
 
-  [[nodiscard]] const std::string &get_table_name() const {
-    if (!m_table) {
-      throw std::runtime_error("Table is not configured!");
+  std::shared_ptr<sql::PreparedStatement> get_delete_statement(
+      const T &entity, connection_lease &connection) const {
+    auto stmt = connection.prepare(delete_query.view());
+
+    bind(*stmt, 1, entity.*TMapping::id.member);
+    if constexpr (has_version) {
+      bind(*stmt, 2, entity.*TMapping::version.member);
     }
-    return m_table->get_name();
+
+    return stmt;
   }
 
- protected:
-  typedef T entity_t;
+  static constexpr std::string_view get_select_query() {
+    return select_query.view();
+  }
 
-  table_configuration &has_table(const std::string &table_name) {
-    m_table = std::make_shared<table_configuration>(table_name);
-    return *m_table;
+  static constexpr std::string_view get_update_query() {
+    return update_query.view();
   }
 
-  id_configuration<T> &has_id(
-      const typename id_configuration<T>::id_selector_t &id_selector,
-      const typename id_configuration<T>::id_setter_t &id_setter) {
-    m_id = std::make_shared<id_configuration<T>>
-        (id_selector, id_setter);
-    return *m_id;
+  static constexpr std::string_view get_delete_query() {
+    return delete_query.view();
   }
 
-  template<typename TProperty>
-  base_property_configuration<T> &has_property(
-      const typename property_configuration<T, TProperty>::property_selector_t &
-      property_selector,
-      const typename property_configuration<T, TProperty>::property_setter_t &
-      property_setter) {
-    std::shared_ptr<property_configuration<T, TProperty>>
-        property =
-        std::make_shared<property_configuration<T, TProperty>>
-            (
-                property_selector, property_setter);
-    m_properties.push_back(std::move(property));
-    return *m_properties.back();
+  static const models::guid &get_id(const T &entity) {
+    return entity.*TMapping::id.member;
   }
 
-  version_configuration<T> &has_version(
-      const typename version_configuration<T>::version_selector_t &version_selector,
-      const typename version_configuration<T>::version_setter_t &version_setter
-  ) {
-    m_version = std::make_shared<version_configuration<T>>(version_selector, version_setter);
-    return *m_version;
+  [[nodiscard]] static constexpr const char *get_table_name() {
+    return table_name.c_str();
   }
 
  private:
-  std::shared_ptr<sql::PreparedStatement> m_insert_statement;
-  std::shared_ptr<sql::PreparedStatement> m_select_statement;
-  std::shared_ptr<sql::PreparedStatement> m_update_statement;
-  std::shared_ptr<sql::PreparedStatement> m_delete_statement;
-  std::shared_ptr<sql::PreparedStatement> m_put_statement;
-  std::shared_ptr<table_configuration> m_table;
-  std::shared_ptr<id_configuration<T>> m_id;
-  std::vector<std::shared_ptr<base_property_configuration<T>>> m_properties;
-  std::shared_ptr<version_configuration<T>> m_version;
+  static constexpr std::string build_column_list() {
+    std::string columns(TMapping::id.name);
+    std::apply([&](const auto &...property) {
+      ((columns += ", ", columns += property.name), ...);
+    }, TMapping::properties);
+    if constexpr (has_version) {
+      columns += ", ";
+      columns += TMapping::version.name;
+    }
+    return columns;
+  }
+
+  static constexpr bool is_deleted_column(std::string_view name) {
+    if constexpr (has_deleted) {
+      return name == TMapping::deleted.name;
+    } else {
+      return false;
+    }
+  }
+
+  static constexpr auto table_name = make_static_string<[] {
+    return std::string(TMapping::table);
+  }>();
+
+  static constexpr auto insert_prefix = make_static_string<[] {
+    return "insert into " + std::string(TMapping::table) + " (" + build_column_list() + ") values ";
+  }>();
+
+  static constexpr auto insert_row = make_static_string<[] {
+    std::string row = "(?";
+    for (size_t i = 1; i < column_count; i++) {
+      row += ", ?";
+    }
+    return row + ")";
+  }>();
+
+  static constexpr auto insert_query = make_static_string<[] {
+    return std::string(insert_prefix.view()) + std::string(insert_row.view());
+  }>();
+
+  static constexpr auto upsert_query = make_static_string<[] {
+    // conflict on another unique key must not overwrite different entity
+    std::string guard = std::string(TMapping::id.name) + " = values(" + std::string(TMapping::id.name) + ")";
+    if constexpr (has_version) {
+      guard += " and " + std::string(TMapping::version.name) + " < values(" + std::string(TMapping::version.name) + ")";
+    }
+    if constexpr (has_deleted) {
+      guard += " and " + std::string(TMapping::deleted.name) + " = 0";
+    }
+
+    std::string query = std::string(insert_query.view()) + " on duplicate key update ";
+    bool first = true;
+    auto assign = [&](std::string_view name) {
+      query += first ? "" : ", ";
+      query += std::string(name) + " = if(" + guard + ", values(" + std::string(name) + "), " + std::string(name) + ")";
+      first = false;
+    };
+    // assignments are applied left to right, so the guard must not change before the last one:
+    // deleted flag is changed only by update and version goes last
+    std::apply([&](const auto &...property) {
+      ((is_deleted_column(property.name) ? void() : assign(property.name)), ...);
+    }, TMapping::properties);
+    if constexpr (has_version) {
+      assign(TMapping::version.name);
+    }
+    return query;
+  }>();
+
+  static constexpr auto select_query = make_static_string<[] {
+    return "select " + build_column_list() + " from " + std::string(TMapping::table) +
+        " where " + std::string(TMapping::id.name) + " = ?";
+  }>();
+
+  static constexpr auto update_query = make_static_string<[] {
+    std::string query = "update " + std::string(TMapping::table) + " set ";
+    bool first = true;
+    std::apply([&](const auto &...property) {
+      ((query += first ? "" : ", ", query += property.name, query += " = ?", first = false), ...);
+    }, TMapping::properties);
+    if constexpr (has_version) {
+      query += first ? "" : ", ";
+      query += std::string(TMapping::version.name) + " = ?";
+    }
+    query += " where " + std::string(TMapping::id.name) + " = ?";
+    if constexpr (has_version) {
+      query += " and " + std::string(TMapping::version.name) + " < ?";
+    }
+    return query;
+  }>();
+
+  static constexpr auto delete_query = make_static_string<[] {
+    std::string query = "delete from " + std::string(TMapping::table) +
+        " where " + std::string(TMapping::id.name) + " = ?";
+    if constexpr (has_version) {
+      query += " and " + std::string(TMapping::version.name) + " = ?";
+    }
+    return query;
+  }>();
+
+  static int32_t configure_insert_statement(int32_t property_index, const T &entity,
+                                            sql::PreparedStatement &stmt) {
+    bind(stmt, property_index++, entity.*TMapping::id.member);
+    std::apply([&](const auto &...property) {
+      (bind(stmt, property_index++, entity.*property.member), ...);
+    }, TMapping::properties);
+    if constexpr (has_version) {
+      bind(stmt, property_index++, entity.*TMapping::version.member);
+    }
+    return property_index;
+  }
 };
 
 } // namespace repository::configurations::common
@@ -0,0 +1,110 @@
+//
+// Created by Daniil Ryzhkov on 17/10/2026.
+//
+
+#pragma once
+
+#include <string>
+#include <string_view>
+
+#include <mariadb/conncpp/PreparedStatement.hpp>
+#include <mariadb/conncpp/ResultSet.hpp>
+
+#include "../../models/guid.hpp"
+#include "../../models/money.hpp"
+
+namespace repository::configurations::common {
+
+// Upper bound of the literal length of a numeric parameter, including separator.
+constexpr size_t MAX_NUMERIC_SIZE = 32;
+
+// Maps entity member to a table column.
+template<typename TEntity, typename TProperty>
+struct column {
+  typedef TEntity entity_t;
+  typedef TProperty property_t;
+
+  constexpr column(std::string_view name, TProperty TEntity::*member) : name(name), member(member) {}
+
+  std::string_view name;
+  TProperty TEntity::*member;
+};
+
+inline void bind(sql::PreparedStatement &stmt, int32_t index, const std::string &value) {
+  stmt.setString(index, value);
+}
+
+inline void bind(sql::PreparedStatement &stmt, int32_t index, const models::guid &value) {
+  sql::bytes bytes(value.data(), models::guid::SIZE);
+  stmt.setBytes(index, &bytes);
+}
+
+inline void bind(sql::PreparedStatement &stmt, int32_t index, int value) {
+  stmt.setInt(index, value);
+}
+
+inline void bind(sql::PreparedStatement &stmt, int32_t index, long value) {
+  stmt.setInt64(index, value);
+}
+
+inline void bind(sql::PreparedStatement &stmt, int32_t index, double value) {
+  stmt.setDouble(index, value);
+}
+
+// Bound as decimal text, so the amount reaches decimal column without rounding.
+inline void bind(sql::PreparedStatement &stmt, int32_t index, const models::money &value) {
+  stmt.setBigDecimal(index, value.str());
+}
+
+inline void bind(sql::PreparedStatement &stmt, int32_t index, bool value) {
+  stmt.setBoolean(index, value);
+}
+
+inline void read(const sql::ResultSet &res, int32_t index, std::string &value) {
+  auto s = res.getString(index);
+  value.assign(s.c_str(), s.length());
+}
+
+// Null id, e.g. of a category without user, is read as nil guid.
+inline void read(const sql::ResultSet &res, int32_t index, models::guid &value) {
+  auto s = res.getString(index);
+  value = s.length() == 0 ? models::guid() : models::guid::from_bytes(std::string_view(s.c_str(), s.length()));
+}
+
+inline void read(const sql::ResultSet &res, int32_t index, int &value) {
+  value = res.getInt(index);
+}
+
+inline void read(const sql::ResultSet &res, int32_t index, long &value) {
+  value = res.getInt64(index);
+}
+
+inline void read(const sql::ResultSet &res, int32_t index, double &value) {
+  value = (double) res.getDouble(index);
+}
+
+inline void read(const sql::ResultSet &res, int32_t index, models::money &value) {
+  auto s = res.getString(index);
+  value = s.length() == 0 ? models::money() : models::money::parse(std::string_view(s.c_str(), s.length()));
+}
+
+inline void read(const sql::ResultSet &res, int32_t index, bool &value) {
+  value = res.getBoolean(index);
+}
+
+// Upper bound of the literal length of a parameter after escaping, including quotes and separator.
+inline size_t get_size(const std::string &value) {
+  return value.size() * 2 + 4;
+}
+
+// Binary literal is prefixed with _binary.
+constexpr size_t get_size(const models::guid &) {
+  return models::guid::SIZE * 2 + 12;
+}
+
+template<typename TProperty>
+constexpr size_t get_size(const TProperty &) {
+  return MAX_NUMERIC_SIZE;
+}
+
+}
@@ -0,0 +1,34 @@
+//
+// Created by Daniil Ryzhkov on 17/10/2026.
+//
+
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <string>
+#include <string_view>
+
+namespace repository::configurations::common {
+
+// Null terminated string computed at compile time.
+template<size_t N>
+struct static_string {
+  std::array<char, N + 1> data{};
+
+  [[nodiscard]] constexpr std::string_view view() const { return {data.data(), N}; }
+  [[nodiscard]] constexpr const char *c_str() const { return data.data(); }
+  [[nodiscard]] static constexpr size_t size() { return N; }
+};
+
+// Evaluates builder returning std::string at compile time and keeps the result in static storage.
+template<auto builder>
+consteval auto make_static_string() {
+  constexpr size_t size = builder().size();
+  static_string<size> result;
+  auto value = builder();
+  std::copy(value.begin(), value.end(), result.data.begin());
+  return result;
+}
+
+}
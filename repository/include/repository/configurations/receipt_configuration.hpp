@@ -9,26 +9,27 @@ namespace repository {
 namespace configurations {
 
 template <>
-class repository_configuration<models::receipt>
-    : public common::base_repository_configuration<models::receipt> {
- public:
-  repository_configuration() {
-    HAS_TABLE("receipts");
-
-    HAS_ID(id) WITH_COLUMN("id");
-
-    HAS_STRING(user_id) WITH_COLUMN("user_id");
-    HAS_STRING(date) WITH_COLUMN("date");
-    HAS_DECIMAL(total_amount) WITH_COLUMN("total_amount");
-    HAS_STRING(currency) WITH_COLUMN("currency");
-    HAS_STRING(store_name) WITH_COLUMN("store_name");
-    HAS_STRING(category) WITH_COLUMN("category");
-    HAS_STRING(state) WITH_COLUMN("state");
-    HAS_STRING(image_name) WITH_COLUMN("image_name");
-    HAS_BOOL(is_deleted) WITH_COLUMN("is_deleted");
-
-    HAS_VERSION();
-  }
+struct entity_mapping<models::receipt> {
+  static constexpr std::string_view table = "receipts";
+
+  static constexpr common::column id{"id", &models::receipt::id};
+
+  static constexpr std::tuple properties{
+      common::column{"user_id", &models::receipt::user_id},
+      common::column{"date", &models::receipt::date},
+      common::column{"total_amount", &models::receipt::total_amount},
+      common::column{"currency", &models::receipt::currency},
+      common::column{"store_name", &models::receipt::store_name},
+      common::column{"category", &models::receipt::category},
+      common::column{"state", &models::receipt::state},
+      common::column{"image_name", &models::receipt::image_name},
+      common::column{"is_deleted", &models::receipt::is_deleted},
+      common::column{"change_seq", &models::receipt::change_seq}
+  };
+
+  static constexpr common::column deleted{"is_deleted", &models::receipt::is_deleted};
+
+  static constexpr common::column version{"version", &models::receipt::version};
 };
 
 }  // namespace configurations
@@ -7,20 +7,18 @@ namespace repository {
 namespace configurations {
 
 template <>
-class repository_configuration<models::receipt_item>
-    : public common::base_repository_configuration<models::receipt_item> {
- public:
-  repository_configuration() {
-    HAS_TABLE("receipt_items");
+struct entity_mapping<models::receipt_item> {
+  static constexpr std::string_view table = "receipt_items";
 
-    HAS_ID(id) WITH_COLUMN("id");
+  static constexpr common::column id{"id", &models::receipt_item::id};
 
-    HAS_STRING(receipt_id) WITH_COLUMN("receipt_id");
-    HAS_STRING(description) WITH_COLUMN("description");
-    HAS_DECIMAL(amount) WITH_COLUMN("amount");
-    HAS_STRING(category) WITH_COLUMN("category");
-    HAS_INT(sort_order) WITH_COLUMN("sort_order");
-  }
+  static constexpr std::tuple properties{
+      common::column{"receipt_id", &models::receipt_item::receipt_id},
+      common::column{"description", &models::receipt_item::description},
+      common::column{"amount", &models::receipt_item::amount},
+      common::column{"category", &models::receipt_item::category},
+      common::column{"sort_order", &models::receipt_item::sort_order}
+  };
 };
 
 }  // namespace configurations
@@ -11,6 +11,7 @@
 #include "repository/configurations/receipt_item_configuration.hpp"
 #include "repository/configurations/user_configuration.hpp"
 #include "repository/configurations/budget_configuration.hpp"
+#include "repository/configurations/change_sequence_configuration.hpp"
 
 namespace repository {
 namespace configurations {
@@ -31,7 +32,8 @@ using registry = configurations_registry<
     models::receipt,
     models::receipt_item,
     models::user,
-    models::budget
+    models::budget,
+    models::change_sequence
 >;
 
 }
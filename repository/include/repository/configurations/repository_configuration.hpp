@@ -5,16 +5,17 @@
 namespace repository {
 namespace configurations {
 
+// Mapping of entity T to a table. Specializations provide:
+//   static constexpr std::string_view table;
+//   static constexpr common::column id;
+//   static constexpr std::tuple<common::column...> properties;
+//   static constexpr common::column version; (optional, enables optimistic concurrency)
+//   static constexpr common::column deleted; (optional, logical deletion flag, also listed in properties)
 template <typename T>
-class repository_configuration;
+struct entity_mapping;
 
 template <typename T>
-class repository_configuration : public common::base_repository_configuration<T> {
- public:
-  repository_configuration() {
-    throw std::runtime_error("No configuration is implemented for model");
-  }
-};
+class repository_configuration : public common::base_repository_configuration<T, entity_mapping<T>> {};
 
 }  // namespace configurations
-}  // namespace repository
\ No newline at end of file
+}  // namespace repository
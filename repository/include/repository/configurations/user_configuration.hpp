@@ -10,14 +10,13 @@
 namespace repository {
 namespace configurations {
 
-template<>
-class repository_configuration<models::user> : public common::base_repository_configuration<models::user> {
- public:
-  repository_configuration() {
-    HAS_TABLE("users");
+template <>
+struct entity_mapping<models::user> {
+  static constexpr std::string_view table = "users";
 
-    HAS_ID(id)WITH_COLUMN("id");
-  }
+  static constexpr common::column id{"id", &models::user::id};
+
+  static constexpr std::tuple<> properties{};
 };
 
 }
@@ -0,0 +1,132 @@
+//
+// Created by Daniil Ryzhkov on 17/10/2026.
+//
+
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include <mariadb/conncpp/Connection.hpp>
+
+#include "connection_settings.hpp"
+#include "statement_cache.hpp"
+
+namespace repository {
+
+class connection_pool;
+
+struct pooled_connection {
+  explicit pooled_connection(size_t statement_cache_size) : statements(statement_cache_size) {}
+
+  std::shared_ptr<sql::Connection> connection;
+  statement_cache statements;
+  size_t max_allowed_packet = 0;
+  std::chrono::steady_clock::time_point last_used;
+  bool needs_validation = false;
+};
+
+class connection_lease {
+ public:
+  connection_lease() = default;
+  connection_lease(connection_pool *pool, std::unique_ptr<pooled_connection> entry);
+  ~connection_lease();
+
+  connection_lease(const connection_lease &) = delete;
+  connection_lease &operator=(const connection_lease &) = delete;
+  connection_lease(connection_lease &&other) noexcept;
+  connection_lease &operator=(connection_lease &&other) noexcept;
+
+  explicit operator bool() const { return m_entry != nullptr; }
+
+  // Returns the leased connection, validating it first if it has been idle
+  // for longer than the pool validation interval or has been invalidated.
+  const std::shared_ptr<sql::Connection> &get();
+
+  // Returns a prepared statement from the statement cache of the leased connection.
+  std::shared_ptr<sql::PreparedStatement> prepare(std::string_view query);
+
+  // Prepares a statement on the leased connection without caching it, for queries that are
+  // unlikely to repeat and would evict the cached ones.
+  std::shared_ptr<sql::PreparedStatement> prepare_uncached(std::string_view query);
+
+  [[nodiscard]] statement_cache_stats get_statement_cache_stats() const;
+
+  // Returns max_allowed_packet of the server, queried once per connection.
+  size_t get_max_allowed_packet();
+
+  // Forces validation on the next get(), e.g. after a failed statement.
+  void invalidate();
+
+  void release();
+
+ private:
+  connection_pool *m_pool = nullptr;
+  std::unique_ptr<pooled_connection> m_entry;
+};
+
+class connection_pool {
+ public:
+  explicit connection_pool(const connection_settings &settings);
+  connection_pool(const connection_settings &settings, std::string connection_string);
+  ~connection_pool();
+
+  connection_pool(const connection_pool &) = delete;
+  connection_pool &operator=(const connection_pool &) = delete;
+
+  connection_lease acquire();
+
+  // Returns idle connection, or opens a new one if the pool is not full.
+  // Returns empty lease instead of waiting when all connections are in use.
+  connection_lease try_acquire();
+
+  [[nodiscard]] size_t get_size() const { return m_size; }
+
+  // Returns whether the pool has a database to connect to.
+  [[nodiscard]] bool is_configured() const { return !m_connection_string.empty(); }
+
+  [[nodiscard]] std::chrono::milliseconds get_slow_query_threshold() const { return m_slow_query_threshold; }
+
+  // Returns number of lost connections reestablished since the pool was created.
+  [[nodiscard]] size_t get_reconnects() const { return m_reconnects; }
+
+ private:
+  friend class connection_lease;
+
+  std::string m_connection_string;
+  size_t m_size;
+  std::chrono::milliseconds m_validation_interval;
+  size_t m_statement_cache_size;
+  std::chrono::milliseconds m_slow_query_threshold;
+  std::atomic<size_t> m_reconnects = 0;
+
+  std::mutex m_mutex;
+  std::condition_variable m_available;
+  std::vector<std::unique_ptr<pooled_connection>> m_idle;
+  size_t m_open = 0;
+
+  connection_lease take(std::unique_lock<std::mutex> &lock);
+  void release(std::unique_ptr<pooled_connection> entry);
+  void validate(pooled_connection &entry);
+  std::unique_ptr<sql::Connection> create_connection();
+};
+
+// Pool of connections to the read replica, not configured if the replica connection string is empty.
+class replica_pool : public connection_pool {
+ public:
+  explicit replica_pool(const connection_settings &settings)
+      : connection_pool(settings, settings.replica_connection_string),
+        m_lag(settings.replica_lag) {}
+
+  [[nodiscard]] std::chrono::milliseconds get_lag() const { return m_lag; }
+
+ private:
+  std::chrono::milliseconds m_lag;
+};
+
+}
@@ -4,6 +4,7 @@
 
 #pragma once
 
+#include <chrono>
 #include <string>
 
 namespace repository {
@@ -15,6 +16,25 @@ struct connection_settings {
         : connection_string(std::move(connection_string)) {}
 
   std::string connection_string;
+
+  // Connection string of the read replica, reads are served by the primary if it is empty.
+  std::string replica_connection_string;
+
+  // Reads of a client stay on the primary for this long after its last write,
+  // so that changes it made are seen despite the replica lag.
+  std::chrono::milliseconds replica_lag = std::chrono::seconds(1);
+
+  // Maximum number of connections kept open by the pool.
+  size_t pool_size = 1;
+
+  // Connections idle for longer than this are pinged before being used again.
+  std::chrono::milliseconds validation_interval = std::chrono::seconds(1);
+
+  // Number of prepared statements cached per connection.
+  size_t statement_cache_size = 64;
+
+  // Queries executing longer than this are logged with shapes of their parameters.
+  std::chrono::milliseconds slow_query_threshold = std::chrono::milliseconds(100);
 };
 
 }
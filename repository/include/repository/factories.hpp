@@ -10,6 +10,7 @@
 #include <lambda/lambda.hpp>
 
 #include "connection_settings.hpp"
+#include "connection_pool.hpp"
 #include "client.hpp"
 
 namespace di {
@@ -20,7 +21,30 @@ struct service_factory<repository::connection_settings> {
   static auto create(TContainer &container, TPointerFactory &&factory) {
     auto stage = lambda::get_stage();
     auto connection_string = repository::get_connection_string(stage, *container.template get<Aws::Client::ClientConfiguration>());
-    return std::move(factory(connection_string));
+    auto settings = factory(connection_string);
+    settings->replica_connection_string = repository::get_replica_connection_string(stage, *container.template get<Aws::Client::ClientConfiguration>());
+    settings->replica_lag = repository::get_replica_lag();
+    settings->pool_size = repository::get_pool_size();
+    settings->validation_interval = repository::get_validation_interval();
+    settings->statement_cache_size = repository::get_statement_cache_size();
+    settings->slow_query_threshold = repository::get_slow_query_threshold();
+    return std::move(settings);
+  }
+};
+
+template<>
+struct service_factory<repository::connection_pool> {
+  template<typename TContainer, typename TPointerFactory>
+  static auto create(TContainer &container, TPointerFactory &&factory) {
+    return std::move(factory(*container.template get<const repository::connection_settings>()));
+  }
+};
+
+template<>
+struct service_factory<repository::replica_pool> {
+  template<typename TContainer, typename TPointerFactory>
+  static auto create(TContainer &container, TPointerFactory &&factory) {
+    return std::move(factory(*container.template get<const repository::connection_settings>()));
   }
 };
 
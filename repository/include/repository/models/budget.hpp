@@ -12,8 +12,9 @@ struct budget {
   guid id;
   guid user_id;
   std::string month;
-  long double amount = 0;
+  money amount;
   int version = 0;
+  long change_seq = 0;
 };
 
 }
@@ -14,6 +14,7 @@ struct category {
   int icon = 0;
   int version = 0;
   bool is_deleted = false;
+  long change_seq = 0;
 };
 
 } // namespace repository::models
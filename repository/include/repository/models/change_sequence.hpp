@@ -0,0 +1,17 @@
+//
+// Created by Daniil Ryzhkov on 17/10/2026.
+//
+
+#pragma once
+
+#include "common.hpp"
+
+namespace repository::models {
+
+// Last change sequence assigned to entities of the user.
+struct change_sequence {
+  guid user_id;
+  long seq = 0;
+};
+
+}
@@ -1,9 +1,4 @@
 #pragma once
 
-#include <string>
-
-namespace repository::models {
-
-typedef std::string guid;
-
-} // namespace repository::models
+#include "guid.hpp"
+#include "money.hpp"
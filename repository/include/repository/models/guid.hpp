@@ -0,0 +1,134 @@
+//
+// Created by Daniil Ryzhkov on 17/10/2026.
+//
+
+#pragma once
+
+#include <array>
+#include <compare>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <ostream>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+
+namespace repository::models {
+
+// Identifier stored as its 16 bytes, in text form xxxxxxxx-xxxx-xxxx-xxxx-xxxxxxxxxxxx outside of the database.
+// Text is parsed in any case and written in lowercase, so ids sent in uppercase come back in lowercase.
+class guid {
+ public:
+  static constexpr size_t SIZE = 16;
+  static constexpr size_t TEXT_SIZE = 36;
+
+  constexpr guid() = default;
+
+  // Throws std::invalid_argument when the text is not a guid.
+  explicit guid(const char *text) : guid(parse(text)) {}
+
+  explicit guid(const std::string &text) : guid(parse(text)) {}
+
+  // Throws std::invalid_argument when the text is not a guid.
+  static guid parse(std::string_view text) {
+    guid output;
+    if (!try_parse(text, output)) {
+      throw std::invalid_argument("Invalid guid");
+    }
+    return output;
+  }
+
+  // Parses text of any case. Every digit is decoded through the table without branching,
+  // invalid digits are collected into one flag checked at the end.
+  static bool try_parse(std::string_view text, guid &output) {
+    if (text.size() != TEXT_SIZE || text[8] != '-' || text[13] != '-' || text[18] != '-' || text[23] != '-') {
+      return false;
+    }
+    guid parsed;
+    uint8_t invalid = 0;
+    for (size_t i = 0; i < SIZE; i++) {
+      auto high = HEX_VALUES[static_cast<uint8_t>(text[HEX_OFFSETS[i]])];
+      auto low = HEX_VALUES[static_cast<uint8_t>(text[HEX_OFFSETS[i] + 1])];
+      invalid |= high | low;
+      parsed.m_bytes[i] = static_cast<uint8_t>((high << 4) | low);
+    }
+    if (invalid & INVALID) {
+      return false;
+    }
+    output = parsed;
+    return true;
+  }
+
+  // Throws std::invalid_argument when there are not exactly 16 bytes.
+  static guid from_bytes(std::string_view bytes) {
+    if (bytes.size() != SIZE) {
+      throw std::invalid_argument("Invalid guid bytes");
+    }
+    guid output;
+    std::memcpy(output.m_bytes.data(), bytes.data(), SIZE);
+    return output;
+  }
+
+  [[nodiscard]] const char *data() const { return reinterpret_cast<const char *>(m_bytes.data()); }
+
+  [[nodiscard]] bool is_nil() const { return *this == guid(); }
+
+  // Writes lowercase text form of 36 characters, without terminating null.
+  void to_chars(char *output) const {
+    for (size_t i = 0; i < SIZE; i++) {
+      output[HEX_OFFSETS[i]] = HEX_DIGITS[m_bytes[i] >> 4];
+      output[HEX_OFFSETS[i] + 1] = HEX_DIGITS[m_bytes[i] & 0x0f];
+    }
+    output[8] = output[13] = output[18] = output[23] = '-';
+  }
+
+  [[nodiscard]] std::string str() const {
+    std::string output(TEXT_SIZE, '-');
+    to_chars(output.data());
+    return output;
+  }
+
+  [[nodiscard]] size_t hash() const {
+    uint64_t high, low;
+    std::memcpy(&high, m_bytes.data(), sizeof(high));
+    std::memcpy(&low, m_bytes.data() + sizeof(high), sizeof(low));
+    return static_cast<size_t>(high ^ (low * 0x9e3779b97f4a7c15ULL));
+  }
+
+  friend bool operator==(const guid &, const guid &) = default;
+  friend std::strong_ordering operator<=>(const guid &, const guid &) = default;
+
+  friend std::ostream &operator<<(std::ostream &stream, const guid &value) {
+    char text[TEXT_SIZE];
+    value.to_chars(text);
+    return stream.write(text, TEXT_SIZE);
+  }
+
+ private:
+  static constexpr uint8_t INVALID = 0xf0;
+  static constexpr char HEX_DIGITS[] = "0123456789abcdef";
+
+  // offsets of the digit pairs of each byte in the text form
+  static constexpr std::array<uint8_t, SIZE> HEX_OFFSETS{0, 2, 4, 6, 9, 11, 14, 16, 19, 21, 24, 26, 28, 30, 32, 34};
+
+  static constexpr std::array<uint8_t, 256> HEX_VALUES = [] {
+    std::array<uint8_t, 256> values{};
+    values.fill(INVALID);
+    for (uint8_t c = '0'; c <= '9'; c++) values[c] = c - '0';
+    for (uint8_t c = 'a'; c <= 'f'; c++) values[c] = c - 'a' + 10;
+    for (uint8_t c = 'A'; c <= 'F'; c++) values[c] = c - 'A' + 10;
+    return values;
+  }();
+
+  std::array<uint8_t, SIZE> m_bytes{};
+};
+
+} // namespace repository::models
+
+template<>
+struct std::hash<repository::models::guid> {
+  size_t operator()(const repository::models::guid &value) const noexcept {
+    return value.hash();
+  }
+};
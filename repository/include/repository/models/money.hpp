@@ -0,0 +1,143 @@
+//
+// Created by Daniil Ryzhkov on 17/10/2026.
+//
+
+#pragma once
+
+#include <charconv>
+#include <cmath>
+#include <compare>
+#include <concepts>
+#include <cstdint>
+#include <ostream>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+
+namespace repository::models {
+
+// Amount of money in cents, stored as decimal(10, 2) and exchanged as decimal text "-123.45".
+// Arithmetic is exact, floating point only appears when converting at the boundaries.
+class money {
+ public:
+  static constexpr int64_t CENTS = 100;
+  // sign, 19 digits of int64 and the decimal point
+  static constexpr size_t MAX_TEXT_SIZE = 21;
+
+  constexpr money() = default;
+
+  static constexpr money from_cents(int64_t cents) {
+    money output;
+    output.m_cents = cents;
+    return output;
+  }
+
+  // Rounds the amount to the nearest cent.
+  template<std::floating_point T>
+  static money from_floating(T amount) {
+    return from_cents(static_cast<int64_t>(std::llround(amount * CENTS)));
+  }
+
+  // Throws std::invalid_argument when the text is not a decimal amount.
+  static money parse(std::string_view text) {
+    money output;
+    if (!try_parse(text, output)) {
+      throw std::invalid_argument("Invalid amount");
+    }
+    return output;
+  }
+
+  // Parses decimal text with at most two fractional digits, e.g. "12", "-0.5" or "123.45".
+  static bool try_parse(std::string_view text, money &output) {
+    bool negative = !text.empty() && text.front() == '-';
+    if (negative) {
+      text.remove_prefix(1);
+    }
+    auto point = text.find('.');
+    auto units_text = text.substr(0, point);
+    auto fraction_text = point == std::string_view::npos ? std::string_view() : text.substr(point + 1);
+    if (units_text.empty() || fraction_text.size() > 2 || (point != std::string_view::npos && fraction_text.empty())) {
+      return false;
+    }
+
+    int64_t units = 0;
+    int64_t fraction = 0;
+    if (!parse_digits(units_text, units) || !parse_digits(fraction_text, fraction)
+        || units > (INT64_MAX - CENTS) / CENTS) {
+      return false;
+    }
+    if (fraction_text.size() == 1) {
+      fraction *= 10;
+    }
+    auto cents = units * CENTS + fraction;
+    output.m_cents = negative ? -cents : cents;
+    return true;
+  }
+
+  [[nodiscard]] constexpr int64_t cents() const { return m_cents; }
+
+  [[nodiscard]] constexpr bool is_zero() const { return m_cents == 0; }
+
+  template<std::floating_point T = double>
+  [[nodiscard]] T to_floating() const {
+    return static_cast<T>(m_cents) / CENTS;
+  }
+
+  // Writes decimal text with two fractional digits, returns pointer past the last written character.
+  // The output must have room for MAX_TEXT_SIZE characters.
+  char *to_chars(char *output) const {
+    uint64_t cents = m_cents < 0 ? 0 - static_cast<uint64_t>(m_cents) : static_cast<uint64_t>(m_cents);
+    if (m_cents < 0) {
+      *output++ = '-';
+    }
+    output = std::to_chars(output, output + MAX_TEXT_SIZE, cents / CENTS).ptr;
+    auto fraction = cents % CENTS;
+    *output++ = '.';
+    *output++ = static_cast<char>('0' + fraction / 10);
+    *output++ = static_cast<char>('0' + fraction % 10);
+    return output;
+  }
+
+  [[nodiscard]] std::string str() const {
+    char text[MAX_TEXT_SIZE];
+    return {text, to_chars(text)};
+  }
+
+  constexpr money &operator+=(money other) {
+    m_cents += other.m_cents;
+    return *this;
+  }
+
+  constexpr money &operator-=(money other) {
+    m_cents -= other.m_cents;
+    return *this;
+  }
+
+  friend constexpr money operator+(money left, money right) { return left += right; }
+  friend constexpr money operator-(money left, money right) { return left -= right; }
+  friend constexpr money operator-(money value) { return from_cents(-value.m_cents); }
+  friend constexpr money operator*(money value, int64_t factor) { return from_cents(value.m_cents * factor); }
+  friend constexpr money operator*(int64_t factor, money value) { return from_cents(value.m_cents * factor); }
+
+  friend constexpr bool operator==(const money &, const money &) = default;
+  friend constexpr std::strong_ordering operator<=>(const money &, const money &) = default;
+
+  friend std::ostream &operator<<(std::ostream &stream, const money &value) {
+    char text[MAX_TEXT_SIZE];
+    return stream.write(text, value.to_chars(text) - text);
+  }
+
+ private:
+  int64_t m_cents = 0;
+
+  static bool parse_digits(std::string_view text, int64_t &output) {
+    if (text.empty()) {
+      output = 0;
+      return true;
+    }
+    auto [end, error] = std::from_chars(text.data(), text.data() + text.size(), output);
+    return error == std::errc() && end == text.data() + text.size() && output >= 0;
+  }
+};
+
+} // namespace repository::models
@@ -10,7 +10,7 @@ struct receipt {
   guid id;
   guid user_id;
   std::string date;
-  long double total_amount;
+  money total_amount;
   std::string currency;
   std::string store_name;
   std::string category;
@@ -18,6 +18,7 @@ struct receipt {
   std::string image_name;
   int version = 0;
   bool is_deleted = false;
+  long change_seq = 0;
 
   std::vector<receipt_item> items;
 
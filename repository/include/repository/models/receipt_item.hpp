@@ -2,13 +2,15 @@
 
 #include <string>
 
+#include "common.hpp"
+
 namespace repository::models {
 
 struct receipt_item {
   guid id;
   guid receipt_id;
   std::string description;
-  long double amount;
+  money amount;
   std::string category;
   int sort_order;
 };
@@ -0,0 +1,115 @@
+//
+// Created by Daniil Ryzhkov on 17/10/2026.
+//
+
+#pragma once
+
+#include <array>
+#include <chrono>
+#include <map>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace repository {
+
+// Latency distribution in fixed exponential buckets.
+class latency_histogram {
+ public:
+  // upper bounds of the buckets in microseconds, longer durations fall into the last bucket
+  static constexpr std::array<int64_t, 12> BOUNDS{
+      100, 250, 500, 1000, 2500, 5000, 10000, 25000, 50000, 100000, 250000, 1000000};
+
+  void record(std::chrono::microseconds duration);
+
+  void merge(const latency_histogram &other);
+
+  [[nodiscard]] size_t get_count() const { return m_count; }
+  [[nodiscard]] std::chrono::microseconds get_total() const { return m_total; }
+  [[nodiscard]] std::chrono::microseconds get_max() const { return m_max; }
+  [[nodiscard]] const std::array<size_t, BOUNDS.size() + 1> &get_buckets() const { return m_buckets; }
+
+  // Returns mean duration of the bucket, zero when the bucket is empty.
+  [[nodiscard]] std::chrono::microseconds get_bucket_mean(size_t bucket) const;
+
+ private:
+  std::array<size_t, BOUNDS.size() + 1> m_buckets{};
+  std::array<std::chrono::microseconds, BOUNDS.size() + 1> m_bucket_totals{};
+  size_t m_count = 0;
+  std::chrono::microseconds m_total{0};
+  std::chrono::microseconds m_max{0};
+};
+
+struct statement_metrics {
+  size_t executions = 0;
+  size_t rows = 0;
+  latency_histogram prepare;
+  latency_histogram execute;
+};
+
+// Shape of a bound parameter, logged with slow queries instead of its value.
+struct parameter_shape {
+  char type;
+  size_t length = 0;
+};
+
+// Metrics of statements executed by a client, keyed by statement, collected until flushed.
+// Queries executing longer than the slow query threshold are logged with shapes of their parameters.
+class query_metrics {
+ public:
+  static constexpr std::chrono::milliseconds DEFAULT_SLOW_QUERY_THRESHOLD{100};
+
+  explicit query_metrics(std::chrono::milliseconds slow_query_threshold = DEFAULT_SLOW_QUERY_THRESHOLD)
+      : m_slow_query_threshold(slow_query_threshold) {}
+
+  void record_prepare(std::string_view statement, std::chrono::microseconds duration);
+
+  void record_execute(std::string_view statement,
+                      std::chrono::microseconds duration,
+                      const std::vector<parameter_shape> &parameters = {});
+
+  void record_rows(std::string_view statement, size_t rows);
+
+  void record_reconnects(size_t reconnects) { m_reconnects += reconnects; }
+
+  // Adds metrics recorded by another client, e.g. on another connection of the pool.
+  void merge(const query_metrics &other);
+
+  [[nodiscard]] const std::map<std::string, statement_metrics, std::less<>> &get_statements() const {
+    return m_statements;
+  }
+  [[nodiscard]] size_t get_reconnects() const { return m_reconnects; }
+  [[nodiscard]] size_t get_slow_queries() const { return m_slow_queries; }
+  [[nodiscard]] bool empty() const { return m_statements.empty() && m_reconnects == 0; }
+
+  // Returns metrics as CloudWatch embedded metric format lines, one per statement and one of totals
+  // attributed to the user.
+  [[nodiscard]] std::vector<std::string> to_emf(std::string_view metrics_namespace,
+                                                std::string_view user_id,
+                                                std::chrono::system_clock::time_point timestamp) const;
+
+  void reset();
+
+ private:
+  std::chrono::microseconds m_slow_query_threshold;
+  std::map<std::string, statement_metrics, std::less<>> m_statements;
+  size_t m_reconnects = 0;
+  size_t m_slow_queries = 0;
+
+  statement_metrics &get(std::string_view statement);
+};
+
+// Measures time elapsed since construction.
+class stopwatch {
+ public:
+  stopwatch() : m_started(std::chrono::steady_clock::now()) {}
+
+  [[nodiscard]] std::chrono::microseconds elapsed() const {
+    return std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - m_started);
+  }
+
+ private:
+  std::chrono::steady_clock::time_point m_started;
+};
+
+}
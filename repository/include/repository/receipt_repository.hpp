@@ -4,6 +4,11 @@
 
 #pragma once
 
+#include <algorithm>
+#include <unordered_map>
+
+#include <lambda/string_utils.hpp>
+
 #include "client.hpp"
 
 namespace repository {
@@ -15,89 +20,89 @@ class receipt_repository {
  public:
   explicit receipt_repository(TRepository repository) : m_repository(std::move(repository)) {}
 
-  lambda::nullable<models::receipt> get(const std::string &user_id, const std::string &image_name) {
-    auto receipt = m_repository->template select<models::receipt>(
-            "select * from receipts where user_id = ? and image_name = ?")
+  lambda::nullable<models::receipt> get(const models::guid &user_id, const std::string &image_name) {
+    static const std::string query = select_with_items("r.user_id = ? and r.image_name = ?");
+    // receipt is scanned right after it is uploaded
+    auto receipts = m_repository->template select<models::receipt>(query, read_route::primary)
         .with_param(user_id)
         .with_param(image_name)
-        .first_or_default();
+        .template all_with<models::receipt_item>(ITEM_PREFIX);
 
-    if (!receipt) {
+    if (receipts->empty()) {
       return {};
     }
 
-    return assemble_model(receipt);
+    return assemble_model(receipts->front());
   }
 
   lambda::nullable<models::receipt> get(const models::guid &receipt_id) {
-    auto receipt = m_repository->template get<models::receipt>(receipt_id);
-    if (!receipt) {
-      return {};
+    static const std::string query = select_with_items("r.id = ?");
+    // receipt may be deleted or its image uploaded right after it is stored
+    auto receipts = m_repository->template select<models::receipt>(query, read_route::primary)
+        .with_param(receipt_id)
+        .template all_with<models::receipt_item>(ITEM_PREFIX);
+
+    if (receipts->empty()) {
+      throw entity_not_found_exception();
     }
-    if (receipt->is_deleted) {
+    if (receipts->front().first->is_deleted) {
       return {};
     }
-    return assemble_model(receipt);
+    return assemble_model(receipts->front());
   }
 
   std::vector<models::receipt> get_by_month(const models::guid &user_id, int year, int month) {
-    auto receipts = m_repository->template select<models::receipt>(
-            "select * from receipts "
-            "where user_id = ? and year(date) = ? and month(date) = ? and is_deleted = 0 "
-            "order by date desc")
-        .with_param(user_id)
-        .with_param(year)
-        .with_param(month)
-        .all();
-
-    auto receipt_items = m_repository->template select<models::receipt_item>(
-            "select ri.* from receipt_items ri "
-            "join receipts r on ri.receipt_id = r.id "
-            "where r.user_id = ? and year(r.date) = ? and month(r.date) = ? and r.is_deleted = 0")
+    if (month < 1 || month > 12) {
+      return {};
+    }
+    auto next_year = month == 12 ? year + 1 : year;
+    auto next_month = month == 12 ? 1 : month + 1;
+    return get_by_date_range(
+        user_id,
+        lambda::string::format("%04d-%02d-01", year, month),
+        lambda::string::format("%04d-%02d-01", next_year, next_month));
+  }
+
+  // Returns receipts dated from the first date inclusive to the second date exclusive.
+  std::vector<models::receipt> get_by_date_range(const models::guid &user_id,
+                                                 const std::string &from,
+                                                 const std::string &to) {
+    // range over raw date column lets ix_user_id_is_deleted_date serve the query
+    // receipts are selected with their items in one statement, so that both are read from the same snapshot
+    static const std::string query = select_with_items(
+        "r.user_id = ? and r.is_deleted = 0 and r.date >= ? and r.date < ?", "r.date desc, r.id");
+    auto receipts = m_repository->template select<models::receipt>(query)
         .with_param(user_id)
-        .with_param(year)
-        .with_param(month)
-        .all();
+        .with_param(from)
+        .with_param(to)
+        .template all_with<models::receipt_item>(ITEM_PREFIX);
 
-    return assemble_models(receipts, receipt_items);
+    return assemble_models(*receipts);
   }
 
   void store(const models::receipt &receipt) {
-    m_repository->execute("start transaction").go();
-
-    try {
-      auto existing_receipt = m_repository->template select<models::receipt>(
-              "select * from receipts where id = ?")
-          .with_param(receipt.id)
-          .first_or_default();
-      if (!existing_receipt) {
-        m_repository->template create<models::receipt>(receipt);
-      } else {
-        if (existing_receipt->is_deleted) {
-          throw concurrency_exception();
-        }
-        m_repository->template update<models::receipt>(receipt);
-      }
-
-      m_repository->execute("delete from receipt_items where receipt_id = ?")
-          .with_param(receipt.id)
-          .go();
-
-      for (int i = 0; i < receipt.items.size(); i++) {
-        auto item = receipt.items[i];
-        item.sort_order = i;
-        m_repository->template create<models::receipt_item>(item);
-      }
-
-      m_repository->execute("commit").go();
-    } catch (std::exception &e) {
-      m_repository->execute("rollback").go();
-      throw;
+    auto transaction = m_repository->transaction();
+
+    auto affected_rows = m_repository->execute_batch(
+        batch()
+            .add_upsert(receipt)
+            .add("delete from receipt_items where receipt_id = ?")
+            .with_param(receipt.id));
+    if (affected_rows[0] == 0) {
+      throw concurrency_exception();
     }
+
+    std::vector<models::receipt_item> items(receipt.items);
+    for (int i = 0; i < items.size(); i++) {
+      items[i].sort_order = i;
+    }
+    m_repository->template create_many<models::receipt_item>(items);
+
+    transaction.commit();
   }
 
   void drop(const models::receipt &receipt) {
-    auto existing_receipt = m_repository->template get<models::receipt>(receipt.id);
+    auto existing_receipt = m_repository->template get<models::receipt>(receipt.id, read_route::primary);
     if (!existing_receipt) {
       return;
     }
@@ -106,55 +111,74 @@ class receipt_repository {
     m_repository->template update<models::receipt>(*existing_receipt);
   }
 
-  std::vector<models::receipt> get_changed(const models::guid &user_id, const std::string &since) {
-    auto receipts = m_repository->template select<models::receipt>(
-            "select * from receipts where user_id = ? and modified_timestamp > ?")
+  // Returns at most limit receipts changed after the change sequence, in order of their changes.
+  // Items are fetched only for receipts that are not deleted.
+  std::vector<models::receipt> get_changed(const models::guid &user_id, long after, int limit) {
+    // page is joined with its items in one statement, so that a receipt stored meanwhile is not sent with stale items
+    static const std::string query =
+        "select r.*, " +
+        configurations::repository_configuration<models::receipt_item>::get_column_list("ri", ITEM_PREFIX) +
+        " from (select * from receipts where user_id = ? and change_seq > ? order by change_seq limit ?) r "
+        "left join receipt_items ri on ri.receipt_id = r.id and r.is_deleted = 0 "
+        "order by r.change_seq, r.id, ri.sort_order";
+    auto receipts = m_repository->template select<models::receipt>(query)
         .with_param(user_id)
-        .with_param(since)
-        .all();
+        .with_param(after)
+        .with_param(limit)
+        .template all_with<models::receipt_item>(ITEM_PREFIX);
 
-    auto receipt_items = m_repository->template select<models::receipt_item>(
-            "select ri.* from receipt_items ri "
-            "join receipts r on ri.receipt_id = r.id "
-            "where r.user_id = ? and r.modified_timestamp > ?")
-        .with_param(user_id)
-        .with_param(since)
-        .all();
+    return assemble_models(*receipts);
+  }
+
+  // Groups items into their receipts in a single pass, keeping receipts order.
+  static std::vector<models::receipt> assemble_models(
+      std::vector<models::receipt> receipts,
+      std::vector<models::receipt_item> receipt_items) {
+    std::unordered_map<models::guid, size_t> index;
+    index.reserve(receipts.size());
+    for (size_t i = 0; i < receipts.size(); i++) {
+      index.emplace(receipts[i].id, i);
+    }
+
+    for (auto &item : receipt_items) {
+      auto found = index.find(item.receipt_id);
+      if (found == index.end()) continue;
+      receipts[found->second].items.push_back(std::move(item));
+    }
 
-    return assemble_models(receipts, receipt_items);
+    return receipts;
   }
 
  private:
   TRepository m_repository;
 
-  models::receipt assemble_model(const std::shared_ptr<models::receipt> &receipt) {
-    auto output = *receipt;
-
-    auto items = m_repository->template select<models::receipt_item>(
-            "select * from receipt_items where receipt_id = ? order by sort_order")
-        .with_param(receipt->id)
-        .all();
-
-    for (const auto &item : *items) {
-      output.items.push_back(*item);
-    }
+  static constexpr auto ITEM_PREFIX = "item_";
+
+  // Selects receipts matching condition on alias r with their items in one round trip.
+  // Rows are ordered by receipt, in the given order of receipts.
+  static std::string select_with_items(const std::string &condition, const std::string &order = "r.id") {
+    return "select r.*, " +
+        configurations::repository_configuration<models::receipt_item>::get_column_list("ri", ITEM_PREFIX) +
+        " from receipts r "
+        "left join receipt_items ri on ri.receipt_id = r.id "
+        "where " + condition + " "
+        "order by " + order + ", ri.sort_order";
+  }
 
+  static models::receipt assemble_model(
+      std::pair<std::shared_ptr<models::receipt>, std::vector<models::receipt_item>> &receipt) {
+    auto output = std::move(*receipt.first);
+    output.items = std::move(receipt.second);
     return output;
   }
 
-  std::vector<models::receipt> assemble_models(
-      const std::shared_ptr<std::vector<std::shared_ptr<models::receipt>>> &receipts,
-      const std::shared_ptr<std::vector<std::shared_ptr<models::receipt_item>>> &receipt_items) {
+  static std::vector<models::receipt> assemble_models(
+      std::vector<std::pair<std::shared_ptr<models::receipt>, std::vector<models::receipt_item>>> &receipts) {
     std::vector<models::receipt> output;
-    output.reserve(receipts->size());
-    for (const auto &receipt : *receipts) {
-      output.push_back(*receipt);
-      for (const auto &item : *receipt_items) {
-        if (item->receipt_id != receipt->id) continue;
-        output.back().items.push_back(*item);
-      }
+    output.reserve(receipts.size());
+    for (auto &receipt : receipts) {
+      output.push_back(assemble_model(receipt));
     }
-
     return output;
   }
 };
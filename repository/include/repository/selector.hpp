@@ -1,6 +1,10 @@
 #pragma once
 
+#include <iterator>
 #include <memory>
+#include <string>
+#include <string_view>
+#include <vector>
 
 #include <mariadb/conncpp/PreparedStatement.hpp>
 #include <utility>
@@ -14,8 +18,10 @@ template <typename T>
 class selector : public base_query {
  public:
   selector(std::shared_ptr<sql::PreparedStatement> stmt,
-           const configurations::repository_configuration<T>& configuration)
-      : m_configuration(configuration), base_query(std::move(stmt)) {}
+           const configurations::repository_configuration<T>& configuration,
+           query_metrics *metrics = nullptr,
+           std::string_view query = {})
+      : m_configuration(configuration), base_query(std::move(stmt), metrics, query) {}
 
   auto& with_param(int t) {
     this->set_param(t);
@@ -37,25 +43,187 @@ class selector : public base_query {
     return *this;
   }
 
-  auto& with_param(long double t) {
+  auto& with_param(const models::money &t) {
+    this->set_param(t);
+    return *this;
+  }
+
+  auto& with_param(const models::guid &t) {
     this->set_param(t);
     return *this;
   }
 
   std::shared_ptr<T> first_or_default() {
-    std::unique_ptr<sql::ResultSet> result(get_stmt()->executeQuery());
+    auto result = execute_query();
     if (result->next()) {
+      record_rows(1);
       return std::move(m_configuration.get_entity(result.get()));
     }
+    record_rows(0);
     return nullptr;
   }
 
   std::shared_ptr<std::vector<std::shared_ptr<T>>> all() {
-    std::unique_ptr<sql::ResultSet> result(get_stmt()->executeQuery());
+    auto result = execute_query();
     auto entities = std::make_shared<std::vector<std::shared_ptr<T>>>();
-    while (result->next()) {
-      entities->push_back(std::move(m_configuration.get_entity(result.get())));
+    if (!result->next()) {
+      record_rows(0);
+      return entities;
+    }
+    auto plan = m_configuration.get_column_plan(result.get());
+    do {
+      entities->push_back(std::move(m_configuration.get_entity(result.get(), plan)));
+    } while (result->next());
+    record_rows(entities->size());
+    return entities;
+  }
+
+  // Calls f for each row with entity read in place, without allocating it.
+  template<typename F>
+  void for_each(F &&f) {
+    auto result = execute_query();
+    size_t rows = 0;
+    if (result->next()) {
+      auto plan = m_configuration.get_column_plan(result.get());
+      T entity;
+      do {
+        m_configuration.read_entity(result.get(), plan, entity);
+        f(entity);
+        rows++;
+      } while (result->next());
+    }
+    record_rows(rows);
+  }
+
+  // Appends all rows to output, constructing entities in place.
+  void into(std::vector<T> &output) {
+    auto result = execute_query();
+    auto size = output.size();
+    if (result->next()) {
+      auto plan = m_configuration.get_column_plan(result.get());
+      do {
+        m_configuration.read_entity(result.get(), plan, output.emplace_back());
+      } while (result->next());
+    }
+    record_rows(output.size() - size);
+  }
+
+  std::vector<T> to_vector() {
+    std::vector<T> output;
+    into(output);
+    return output;
+  }
+
+  class row_iterator;
+
+  // Lazy input range over rows, each row is read when iterator is advanced.
+  class row_range {
+   public:
+    explicit row_range(selector &s) : m_selector(s) {}
+
+    ~row_range() {
+      if (m_result) {
+        m_selector.record_rows(m_rows);
+      }
+    }
+
+    row_range(const row_range &) = delete;
+    row_range &operator=(const row_range &) = delete;
+
+    row_iterator begin() {
+      m_result = m_selector.execute_query();
+      return row_iterator(this);
     }
+
+    std::default_sentinel_t end() { return {}; }
+
+   private:
+    friend class row_iterator;
+
+    selector &m_selector;
+    std::unique_ptr<sql::ResultSet> m_result;
+    typename configurations::repository_configuration<T>::column_plan m_plan{};
+    bool m_has_plan = false;
+    size_t m_rows = 0;
+    T m_current;
+
+    bool next() {
+      if (!m_result->next()) {
+        return false;
+      }
+      if (!m_has_plan) {
+        m_plan = m_selector.m_configuration.get_column_plan(m_result.get());
+        m_has_plan = true;
+      }
+      m_selector.m_configuration.read_entity(m_result.get(), m_plan, m_current);
+      m_rows++;
+      return true;
+    }
+  };
+
+  class row_iterator {
+   public:
+    using iterator_concept = std::input_iterator_tag;
+    using value_type = T;
+    using difference_type = std::ptrdiff_t;
+
+    row_iterator() = default;
+    explicit row_iterator(row_range *range) : m_range(range) { advance(); }
+
+    T &operator*() const { return m_range->m_current; }
+    T *operator->() const { return &m_range->m_current; }
+
+    row_iterator &operator++() {
+      advance();
+      return *this;
+    }
+    void operator++(int) { advance(); }
+
+    friend bool operator==(const row_iterator &it, std::default_sentinel_t) { return it.m_range == nullptr; }
+
+   private:
+    row_range *m_range = nullptr;
+
+    void advance() {
+      if (m_range && !m_range->next()) {
+        m_range = nullptr;
+      }
+    }
+  };
+
+  // Usage: for (auto &entity : selector.rows()) { ... }
+  // Entity is overwritten by the next row, move it out to keep it.
+  row_range rows() {
+    return row_range(*this);
+  }
+
+  // Reads rows of entities joined with their children, whose columns are labeled with prefix.
+  // Rows must be ordered by entity, a child with null id stands for an entity without children.
+  template<typename TChild>
+  std::shared_ptr<std::vector<std::pair<std::shared_ptr<T>, std::vector<TChild>>>> all_with(std::string_view prefix) {
+    auto result = execute_query();
+    auto entities = std::make_shared<std::vector<std::pair<std::shared_ptr<T>, std::vector<TChild>>>>();
+    if (!result->next()) {
+      record_rows(0);
+      return entities;
+    }
+
+    configurations::repository_configuration<TChild> child_configuration;
+    auto plan = m_configuration.get_column_plan(result.get());
+    auto child_plan = child_configuration.get_column_plan(result.get(), prefix);
+    size_t rows = 0;
+    do {
+      rows++;
+      models::guid id;
+      configurations::common::read(*result, plan[0], id);
+      if (entities->empty() || m_configuration.get_id(*entities->back().first) != id) {
+        entities->emplace_back(m_configuration.get_entity(result.get(), plan), std::vector<TChild>());
+      }
+      if (!result->isNull(child_plan[0])) {
+        entities->back().second.push_back(std::move(*child_configuration.get_entity(result.get(), child_plan)));
+      }
+    } while (result->next());
+    record_rows(rows);
     return entities;
   }
 
@@ -10,13 +10,16 @@ namespace repository {
 
 class statement : public repository::base_query {
  public:
-  explicit statement(std::shared_ptr<sql::PreparedStatement> stmt);
+  explicit statement(std::shared_ptr<sql::PreparedStatement> stmt,
+                     query_metrics *metrics = nullptr,
+                     std::string_view query = {});
 
   statement &with_param(int t);
   statement &with_param(double t);
   statement &with_param(long t);
   statement &with_param(const std::string &t);
-  statement &with_param(long double t);
+  statement &with_param(const models::money &t);
+  statement &with_param(const models::guid &t);
   void go();
 };
 
@@ -0,0 +1,58 @@
+//
+// Created by Daniil Ryzhkov on 17/10/2026.
+//
+
+#pragma once
+
+#include <list>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+
+#include <mariadb/conncpp/Connection.hpp>
+#include <mariadb/conncpp/PreparedStatement.hpp>
+
+namespace repository {
+
+struct statement_cache_stats {
+  size_t hits = 0;
+  size_t misses = 0;
+  // cached statement was in use, so a separate one was prepared
+  size_t busy = 0;
+};
+
+// LRU cache of prepared statements of a single connection, keyed by sql text.
+class statement_cache {
+ public:
+  explicit statement_cache(size_t capacity);
+
+  // Returns cached statement with cleared parameters, or prepares a new one.
+  // A statement still held by a caller is never handed out twice, an uncached one is prepared instead.
+  std::shared_ptr<sql::PreparedStatement> prepare(sql::Connection &connection, std::string_view query);
+
+  static std::shared_ptr<sql::PreparedStatement> prepare_uncached(sql::Connection &connection,
+                                                                  std::string_view query);
+
+  // Drops all statements, e.g. when the underlying connection was recreated.
+  // Hit and miss counters are preserved.
+  void clear();
+
+  [[nodiscard]] const statement_cache_stats &get_stats() const { return m_stats; }
+
+ private:
+  using entry_t = std::pair<std::string, std::shared_ptr<sql::PreparedStatement>>;
+
+  // allows lookup by string_view without allocating a key
+  struct query_hash {
+    using is_transparent = void;
+    size_t operator()(std::string_view query) const { return std::hash<std::string_view>{}(query); }
+  };
+
+  size_t m_capacity;
+  std::list<entry_t> m_entries;
+  std::unordered_map<std::string, std::list<entry_t>::iterator, query_hash, std::equal_to<>> m_index;
+  statement_cache_stats m_stats;
+};
+
+}
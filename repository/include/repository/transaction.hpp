@@ -0,0 +1,54 @@
+//
+// Created by Daniil Ryzhkov on 17/10/2026.
+//
+
+#pragma once
+
+#include <chrono>
+#include <memory>
+
+#include <mariadb/conncpp/Connection.hpp>
+
+namespace repository {
+
+struct transaction_stats {
+  size_t committed = 0;
+  size_t rolled_back = 0;
+  std::chrono::microseconds total_duration{0};
+  std::chrono::microseconds max_duration{0};
+};
+
+// Transaction state of the connection used by a client.
+struct transaction_context {
+  size_t depth = 0;
+  transaction_stats stats;
+};
+
+// Scope guard of a transaction, rolled back on destruction unless committed.
+// Outermost transaction disables autocommit of the connection, nested ones are savepoints.
+class transaction {
+ public:
+  transaction(std::shared_ptr<sql::Connection> connection, transaction_context &context);
+  ~transaction();
+
+  transaction(const transaction &) = delete;
+  transaction &operator=(const transaction &) = delete;
+  transaction(transaction &&other) noexcept;
+  transaction &operator=(transaction &&other) = delete;
+
+  void commit();
+  void rollback();
+
+  [[nodiscard]] bool is_nested() const { return m_savepoint != nullptr; }
+
+ private:
+  std::shared_ptr<sql::Connection> m_connection;
+  transaction_context *m_context;
+  std::unique_ptr<sql::Savepoint> m_savepoint;
+  std::chrono::steady_clock::time_point m_started;
+  bool m_active = true;
+
+  void finish(bool committed);
+};
+
+}
@@ -0,0 +1,83 @@
+//
+// Created by Daniil Ryzhkov on 17/10/2026.
+//
+
+#include "integration_tests_common/benchmark.hpp"
+#include "repository/receipt_repository.hpp"
+
+using namespace repository::models;
+
+typedef std::vector<receipt> receipts_t;
+typedef std::vector<receipt_item> receipt_items_t;
+
+static void generate(size_t receipts_count, size_t items_count, receipts_t &receipts, receipt_items_t &items) {
+  receipts.clear();
+  items.clear();
+  receipts.reserve(receipts_count);
+  items.reserve(items_count);
+  for (size_t i = 0; i < receipts_count; i++) {
+    auto &r = receipts.emplace_back();
+    r.id = guid::parse(lambda::string::format("00000000-0000-4000-8000-%012zu", i));
+  }
+  for (size_t i = 0; i < items_count; i++) {
+    auto &item = items.emplace_back();
+    item.id = guid::parse(lambda::string::format("10000000-0000-4000-8000-%012zu", i));
+    item.receipt_id = receipts[i % receipts_count].id;
+    item.description = "description";
+    item.sort_order = (int) (i / receipts_count);
+  }
+}
+
+// former implementation comparing every item against every receipt
+static std::vector<receipt> assemble_models_nested(receipts_t receipts, receipt_items_t items) {
+  std::vector<receipt> output;
+  output.reserve(receipts.size());
+  for (const auto &r : receipts) {
+    output.push_back(r);
+    for (const auto &item : items) {
+      if (item.receipt_id != r.id) continue;
+      output.back().items.push_back(item);
+    }
+  }
+  return output;
+}
+
+// Counts items assembled into their receipt, weighted by position, so that misplaced or reordered items change it.
+static size_t checksum(const std::vector<receipt> &output) {
+  size_t sum = output.size();
+  for (const auto &r : output) {
+    for (size_t k = 0; k < r.items.size(); k++) {
+      sum += (r.items[k].receipt_id == r.id) * (k + 1);
+    }
+  }
+  return sum;
+}
+
+template<typename TAssemble>
+static benchmark::measurement measure(size_t receipts_count, size_t items_count, TAssemble &&assemble) {
+  auto prepare = [receipts_count, items_count]() {
+    std::pair<receipts_t, receipt_items_t> input;
+    generate(receipts_count, items_count, input.first, input.second);
+    return input;
+  };
+  return benchmark::measure<std::milli>(1, prepare, [&](auto &input) {
+    auto output = assemble(std::move(input.first), std::move(input.second));
+    EXPECT_EQ(output.size(), receipts_count);
+    EXPECT_EQ(output.back().items.size(), items_count / receipts_count);
+    return checksum(output);
+  });
+}
+
+TEST(assemble_models_benchmark, small_dataset) {
+  auto nested = measure(1000, 20000, assemble_models_nested);
+  auto grouped = measure(1000, 20000, repository::receipt_repository<>::assemble_models);
+
+  benchmark::compare("1k receipts / 20k items nested loop vs grouped", "ms", nested, grouped);
+}
+
+TEST(assemble_models_benchmark, large_dataset) {
+  // nested loop is not measured here, 2 billion id comparisons take minutes
+  auto grouped = measure(10000, 200000, repository::receipt_repository<>::assemble_models);
+
+  benchmark::report("10k receipts / 200k items grouped", "ms", grouped);
+}
@@ -0,0 +1,30 @@
+//
+// Created by Daniil Ryzhkov on 17/10/2026.
+//
+
+#pragma once
+
+#include <aws/core/client/ClientConfiguration.h>
+
+#include "di/container.hpp"
+#include "repository/client.hpp"
+#include "repository/factories.hpp"
+
+#include "integration_tests_common/benchmark.hpp"
+#include "base_repository_integration_test.hpp"
+
+// Database with a client, shared by the repository benchmarks.
+class base_repository_benchmark : public base_repository_integration_test {
+ protected:
+  std::shared_ptr<sql::Connection> get_connection() override {
+    return services.get<repository::t_client>()->get_connection();
+  }
+
+  di::container<
+      di::singleton<Aws::Client::ClientConfiguration>,
+      di::singleton<repository::connection_settings>,
+      di::singleton<repository::connection_pool>,
+      di::singleton<repository::replica_pool>,
+      di::scoped<repository::t_client, repository::client<>>
+  > services;
+};
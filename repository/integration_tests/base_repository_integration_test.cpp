@@ -7,5 +7,6 @@
 void base_repository_integration_test::SetUp() {
   repository_integration_test::SetUp();
   auto connection = get_connection();
-  std::unique_ptr<sql::Statement>(connection->createStatement())->execute("insert into users (id) values ('" DEFAULT_USER_ID "')");
+  std::unique_ptr<sql::Statement>(connection->createStatement())->execute(
+      "insert into users (id) values (unhex(replace('" DEFAULT_USER_ID "', '-', '')))");
 }
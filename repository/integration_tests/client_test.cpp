@@ -10,12 +10,25 @@
 #include "di/container.hpp"
 #include "repository/factories.hpp"
 
+#include "repository/models/change_sequence.hpp"
 #include "repository/models/receipt.hpp"
 #include "base_repository_integration_test.hpp"
 
 using namespace di;
 using namespace repository::models;
 
+#define TRANSACTION_USER_ID "8f0e6f0a-1c2b-4d3e-9f40-000000000003"
+#define OUTER_USER_ID "8f0e6f0a-1c2b-4d3e-9f40-000000000004"
+#define NESTED_USER_ID "8f0e6f0a-1c2b-4d3e-9f40-000000000005"
+#define BATCH_USER_ID "8f0e6f0a-1c2b-4d3e-9f40-000000000006"
+#define NEW_BATCH_USER_ID "8f0e6f0a-1c2b-4d3e-9f40-000000000007"
+#define MISSING_USER_ID "8f0e6f0a-1c2b-4d3e-9f40-000000000008"
+#define FIRST_USER_ID "8f0e6f0a-1c2b-4d3e-9f40-000000000009"
+#define SECOND_USER_ID "8f0e6f0a-1c2b-4d3e-9f40-00000000000a"
+#define UNCOMMITTED_USER_ID "8f0e6f0a-1c2b-4d3e-9f40-00000000000b"
+#define ROUTED_USER_ID "8f0e6f0a-1c2b-4d3e-9f40-00000000000c"
+#define MANY_USER_ID_PREFIX "8f0e6f0a-1c2b-4d3e-9f40-0000000001"
+
 class client_test : public base_repository_integration_test {
  protected:
   std::shared_ptr<sql::Connection> get_connection() override {
@@ -25,8 +38,34 @@ class client_test : public base_repository_integration_test {
   container<
       singleton<Aws::Client::ClientConfiguration>,
       singleton<repository::connection_settings>,
+      singleton<repository::connection_pool>,
+      singleton<repository::replica_pool>,
       scoped<repository::t_client, repository::client<>>
   > services;
+
+  using pooled_client = repository::client<
+      std::shared_ptr<repository::connection_pool>,
+      std::shared_ptr<repository::replica_pool>>;
+
+  // Creates client on its own pools, with all their connections using the test database.
+  std::unique_ptr<pooled_client> create_client(const repository::connection_settings &settings) {
+    auto pool = std::make_shared<repository::connection_pool>(settings);
+    auto replica = std::make_shared<repository::replica_pool>(settings);
+    use_test_database(*pool);
+    if (replica->is_configured()) {
+      use_test_database(*replica);
+    }
+    return std::make_unique<pooled_client>(pool, replica);
+  }
+
+  void use_test_database(repository::connection_pool &pool) {
+    auto schema = get_connection()->getSchema();
+    std::vector<repository::connection_lease> leases;
+    for (size_t i = 0; i < pool.get_size(); i++) {
+      leases.push_back(pool.acquire());
+      leases.back().get()->setSchema(schema);
+    }
+  }
 };
 
 TEST_F(client_test, should_reconnect_if_connection_is_lost) {
@@ -41,24 +80,334 @@ TEST_F(client_test, should_reconnect_if_connection_is_lost) {
 
 TEST_F(client_test, should_invalidate_get_statement_if_connection_is_lost) {
   auto client = services.get<repository::t_client>();
-  auto u1 = client->get<user>(DEFAULT_USER_ID);
+  auto u1 = client->get<user>(guid(DEFAULT_USER_ID));
   auto connection = client->get_connection();
   std::unique_ptr<sql::Statement>(connection->createStatement())->execute("set session wait_timeout=1");
   std::unique_ptr<sql::Statement>(connection->createStatement())->execute("set session interactive_timeout=1");
   std::this_thread::sleep_for(std::chrono::seconds(2));
-  auto u2 = client->get<user>(DEFAULT_USER_ID);
+  auto u2 = client->get<user>(guid(DEFAULT_USER_ID));
   ASSERT_EQ(u1->id, u2->id);
 }
 
 TEST_F(client_test, should_invalidate_create_statment_if_connection_is_lost) {
   auto client = services.get<repository::t_client>();
-  user u1 = { "user1"};
+  user u1 = { guid("8f0e6f0a-1c2b-4d3e-9f40-000000000001") };
   client->create(u1);
   auto connection = client->get_connection();
   std::unique_ptr<sql::Statement>(connection->createStatement())->execute("set session wait_timeout=1");
   std::unique_ptr<sql::Statement>(connection->createStatement())->execute("set session interactive_timeout=1");
   std::this_thread::sleep_for(std::chrono::seconds(2));
-  user u2 = { "user2" };
+  user u2 = { guid("8f0e6f0a-1c2b-4d3e-9f40-000000000002") };
   client->create(u2);
   ASSERT_TRUE(u1.id != u2.id);
 }
+
+TEST_F(client_test, should_reuse_prepared_statement) {
+  auto client = services.get<repository::t_client>();
+  client->select<user>("select * from users where id = ?").with_param(guid(DEFAULT_USER_ID)).all();
+  auto before = client->get_statement_cache_stats();
+  auto users = client->select<user>("select * from users where id = ?").with_param(guid(DEFAULT_USER_ID)).all();
+  auto after = client->get_statement_cache_stats();
+  ASSERT_EQ(users->size(), 1);
+  ASSERT_EQ(after.hits, before.hits + 1);
+  ASSERT_EQ(after.misses, before.misses);
+}
+
+TEST_F(client_test, should_not_share_statement_of_live_selectors) {
+  auto client = services.get<repository::t_client>();
+  client->create(user{guid(FIRST_USER_ID)});
+  client->create(user{guid(SECOND_USER_ID)});
+  const std::string query = "select * from users where id = ?";
+
+  auto before = client->get_statement_cache_stats();
+  auto first = client->select<user>(query).with_param(guid(FIRST_USER_ID));
+  auto second = client->select<user>(query).with_param(guid(SECOND_USER_ID));
+  auto first_users = first.all();
+  auto second_users = second.all();
+  auto after = client->get_statement_cache_stats();
+
+  ASSERT_EQ(first_users->size(), 1);
+  ASSERT_EQ(first_users->front()->id, guid(FIRST_USER_ID));
+  ASSERT_EQ(second_users->size(), 1);
+  ASSERT_EQ(second_users->front()->id, guid(SECOND_USER_ID));
+  ASSERT_EQ(after.busy, before.busy + 1);
+}
+
+TEST_F(client_test, should_not_share_statement_with_nested_query) {
+  auto client = services.get<repository::t_client>();
+  client->create(user{guid(FIRST_USER_ID)});
+  client->create(user{guid(SECOND_USER_ID)});
+  const std::string query = "select * from users where id = ?";
+
+  std::vector<guid> outer;
+  std::vector<guid> nested;
+  client->select<user>(query).with_param(guid(FIRST_USER_ID)).for_each([&](const user &u) {
+    outer.push_back(u.id);
+    for (auto &n : *client->select<user>(query).with_param(guid(SECOND_USER_ID)).all()) {
+      nested.push_back(n->id);
+    }
+  });
+
+  ASSERT_EQ(outer, std::vector<guid>{guid(FIRST_USER_ID)});
+  ASSERT_EQ(nested, std::vector<guid>{guid(SECOND_USER_ID)});
+}
+
+TEST_F(client_test, should_not_cache_multi_row_inserts) {
+  auto client = services.get<repository::t_client>();
+  auto before = client->get_statement_cache_stats();
+  for (int count = 2; count <= 4; count++) {
+    std::vector<user> users;
+    for (int i = 0; i < count; i++) {
+      users.push_back({guid::parse(MANY_USER_ID_PREFIX + std::to_string(count) + std::to_string(i))});
+    }
+    client->create_many<user>(users);
+  }
+  auto after = client->get_statement_cache_stats();
+  ASSERT_EQ(after.hits, before.hits);
+  ASSERT_EQ(after.misses, before.misses);
+}
+
+TEST_F(client_test, should_stream_rows_without_materialization) {
+  auto client = services.get<repository::t_client>();
+  const std::string query = "select * from users where id = ?";
+
+  std::vector<user> visited;
+  client->select<user>(query).with_param(guid(DEFAULT_USER_ID)).for_each([&visited](const user &u) {
+    visited.push_back(u);
+  });
+  ASSERT_EQ(visited.size(), 1);
+  ASSERT_EQ(visited[0].id, guid(DEFAULT_USER_ID));
+
+  std::vector<user> users;
+  client->select<user>(query).with_param(guid(DEFAULT_USER_ID)).into(users);
+  ASSERT_EQ(users.size(), 1);
+  ASSERT_EQ(users[0].id, guid(DEFAULT_USER_ID));
+
+  size_t count = 0;
+  auto s = client->select<user>(query).with_param(guid(DEFAULT_USER_ID));
+  for (auto &u : s.rows()) {
+    ASSERT_EQ(u.id, guid(DEFAULT_USER_ID));
+    count++;
+  }
+  ASSERT_EQ(count, 1);
+}
+
+TEST_F(client_test, should_store_guid_in_16_bytes) {
+  auto client = services.get<repository::t_client>();
+  auto stored = client->select<change_sequence>("select id as user_id, length(id) as seq from users where id = ?")
+      .with_param(guid(DEFAULT_USER_ID))
+      .to_vector();
+  ASSERT_EQ(stored.size(), 1);
+  ASSERT_EQ(stored[0].user_id, guid(DEFAULT_USER_ID));
+  ASSERT_EQ(stored[0].seq, (long) guid::SIZE);
+}
+
+TEST_F(client_test, should_commit_transaction) {
+  auto client = services.get<repository::t_client>();
+  {
+    auto transaction = client->transaction();
+    client->create(user{.id = guid(TRANSACTION_USER_ID)});
+    transaction.commit();
+  }
+  ASSERT_NO_THROW(client->get<user>(guid(TRANSACTION_USER_ID)));
+  ASSERT_EQ(client->get_transaction_stats().committed, 1);
+}
+
+TEST_F(client_test, should_rollback_transaction_on_scope_exit) {
+  auto client = services.get<repository::t_client>();
+  {
+    auto transaction = client->transaction();
+    client->create(user{.id = guid(TRANSACTION_USER_ID)});
+  }
+  ASSERT_THROW(client->get<user>(guid(TRANSACTION_USER_ID)), repository::entity_not_found_exception);
+  ASSERT_EQ(client->get_transaction_stats().rolled_back, 1);
+}
+
+TEST_F(client_test, should_rollback_nested_transaction_to_savepoint) {
+  auto client = services.get<repository::t_client>();
+  {
+    auto transaction = client->transaction();
+    client->create(user{.id = guid(OUTER_USER_ID)});
+    {
+      auto nested = client->transaction();
+      ASSERT_TRUE(nested.is_nested());
+      client->create(user{.id = guid(NESTED_USER_ID)});
+      nested.rollback();
+    }
+    transaction.commit();
+  }
+  ASSERT_NO_THROW(client->get<user>(guid(OUTER_USER_ID)));
+  ASSERT_THROW(client->get<user>(guid(NESTED_USER_ID)), repository::entity_not_found_exception);
+  ASSERT_EQ(client->get_transaction_stats().committed, 1);
+  ASSERT_EQ(client->get_transaction_stats().rolled_back, 0);
+}
+
+TEST_F(client_test, should_execute_batch_in_one_query) {
+  auto client = services.get<repository::t_client>();
+  client->create(user{.id = guid(BATCH_USER_ID)});
+
+  auto affected_rows = client->execute_batch(
+      repository::batch()
+          .add("delete from users where id = ?").with_param(guid(BATCH_USER_ID))
+          .add("delete from users where id = ?").with_param(guid(MISSING_USER_ID))
+          .add("insert into users (id) values (?)").with_param(guid(NEW_BATCH_USER_ID)));
+
+  ASSERT_EQ(affected_rows, (std::vector<int64_t>{1, 0, 1}));
+  ASSERT_THROW(client->get<user>(guid(BATCH_USER_ID)), repository::entity_not_found_exception);
+  ASSERT_NO_THROW(client->get<user>(guid(NEW_BATCH_USER_ID)));
+}
+
+TEST_F(client_test, should_read_result_sets_of_batch_in_order) {
+  auto client = services.get<repository::t_client>();
+  client->create(user{.id = guid(FIRST_USER_ID)});
+  client->create(user{.id = guid(SECOND_USER_ID)});
+
+  auto statements = repository::batch()
+      .add("set @batch_user = ?").with_param(guid(SECOND_USER_ID))
+      .add("select * from users where id = ?").with_param(guid(FIRST_USER_ID))
+      .add("select * from users where id = @batch_user")
+      .add("select * from users where id = ?").with_param(guid(MISSING_USER_ID));
+  auto reader = client->query_batch(statements);
+
+  auto first = reader.next<user>();
+  auto second = reader.next<user>();
+  auto missing = reader.next<user>();
+
+  ASSERT_EQ(first.size(), 1);
+  ASSERT_EQ(first[0].id, guid(FIRST_USER_ID));
+  ASSERT_EQ(second.size(), 1);
+  ASSERT_EQ(second[0].id, guid(SECOND_USER_ID));
+  ASSERT_TRUE(missing.empty());
+  ASSERT_THROW(reader.next<user>(), std::runtime_error);
+
+  const auto &metrics = client->get_query_metrics().get_statements();
+  auto batch_metrics = metrics.find(statements.get_query());
+  ASSERT_NE(batch_metrics, metrics.end());
+  ASSERT_EQ(batch_metrics->second.rows, 2);
+}
+
+TEST(latency_histogram, should_value_buckets_by_mean_duration) {
+  repository::latency_histogram histogram;
+  histogram.record(std::chrono::microseconds(101));
+  histogram.record(std::chrono::microseconds(149));
+  histogram.record(std::chrono::microseconds(2000000));
+  ASSERT_EQ(histogram.get_bucket_mean(1), std::chrono::microseconds(125));
+  ASSERT_EQ(histogram.get_bucket_mean(0), std::chrono::microseconds(0));
+  ASSERT_EQ(histogram.get_bucket_mean(repository::latency_histogram::BOUNDS.size()), std::chrono::microseconds(2000000));
+
+  repository::query_metrics metrics;
+  metrics.record_execute("select 1", std::chrono::microseconds(101));
+  metrics.record_execute("select 1", std::chrono::microseconds(149));
+  auto lines = metrics.to_emf("Test", "user", std::chrono::system_clock::now());
+  ASSERT_NE(lines[0].find(R"("ExecuteTime":{"Values":[0.125],"Counts":[2]})"), std::string::npos);
+}
+
+TEST_F(client_test, should_record_query_metrics) {
+  auto client = services.get<repository::t_client>();
+  client->create(user{.id = guid(FIRST_USER_ID)});
+  client->create(user{.id = guid(SECOND_USER_ID)});
+
+  std::string query = "select * from users where id in (?, ?)";
+  auto users = client->select<user>(query)
+      .with_param(guid(FIRST_USER_ID))
+      .with_param(guid(SECOND_USER_ID))
+      .to_vector();
+
+  const auto &statements = client->get_query_metrics().get_statements();
+  auto select_metrics = statements.find(query);
+  ASSERT_NE(select_metrics, statements.end());
+  ASSERT_EQ(select_metrics->second.executions, 1);
+  ASSERT_EQ(select_metrics->second.rows, users.size());
+  ASSERT_EQ(select_metrics->second.prepare.get_count(), 1);
+  ASSERT_EQ(select_metrics->second.execute.get_count(), 1);
+
+  auto insert_metrics = statements.find(repository::configurations::repository_configuration<user>::get_insert_query());
+  ASSERT_NE(insert_metrics, statements.end());
+  ASSERT_EQ(insert_metrics->second.executions, 2);
+  ASSERT_EQ(insert_metrics->second.rows, 2);
+
+  testing::internal::CaptureStdout();
+  client->flush_metrics(FIRST_USER_ID);
+  auto output = testing::internal::GetCapturedStdout();
+
+  ASSERT_NE(output.find(R"("Namespace":"ReceiptScan/Database")"), std::string::npos);
+  ASSERT_NE(output.find(R"json("Statement":"select * from users where id in (?, ?)")json"), std::string::npos);
+  ASSERT_NE(output.find("\"UserId\":\"" FIRST_USER_ID "\",\"Queries\":3"), std::string::npos);
+  ASSERT_TRUE(client->get_query_metrics().empty());
+}
+
+TEST_F(client_test, should_fan_out_queries_to_spare_connections) {
+  auto settings = *services.get<repository::connection_settings>();
+  settings.pool_size = 2;
+  auto client_ptr = create_client(settings);
+  auto &client = *client_ptr;
+  client.create(user{.id = guid(FIRST_USER_ID)});
+  client.create(user{.id = guid(SECOND_USER_ID)});
+
+  std::thread::id first_thread, second_thread;
+  auto [first, all] = client.fan_out(
+      [&](auto &c) {
+        first_thread = std::this_thread::get_id();
+        return c.template select<user>("select * from users where id = ?")
+            .with_param(guid(FIRST_USER_ID))
+            .to_vector();
+      },
+      [&](auto &c) {
+        second_thread = std::this_thread::get_id();
+        return c.template select<user>("select * from users where id <> ? order by id")
+            .with_param(guid(DEFAULT_USER_ID))
+            .to_vector();
+      });
+
+  ASSERT_EQ(first.size(), 1);
+  ASSERT_EQ(first[0].id, guid(FIRST_USER_ID));
+  ASSERT_EQ(all.size(), 2);
+  ASSERT_NE(first_thread, second_thread);
+
+  // metrics of the other connection are merged into the client
+  const auto &statements = client.get_query_metrics().get_statements();
+  ASSERT_EQ(statements.at("select * from users where id <> ? order by id").executions, 1);
+}
+
+TEST_F(client_test, should_fan_out_sequentially_inside_transaction) {
+  auto settings = *services.get<repository::connection_settings>();
+  settings.pool_size = 2;
+  auto client_ptr = create_client(settings);
+  auto &client = *client_ptr;
+
+  auto transaction = client.transaction();
+  client.create(user{.id = guid(UNCOMMITTED_USER_ID)});
+  auto [first, second] = client.fan_out(
+      [](auto &c) {
+        return c.template select<user>("select * from users where id = ?")
+            .with_param(guid(UNCOMMITTED_USER_ID))
+            .to_vector();
+      },
+      [](auto &c) {
+        return c.template select<user>("select * from users where id = ?")
+            .with_param(guid(UNCOMMITTED_USER_ID))
+            .to_vector();
+      });
+  transaction.rollback();
+
+  ASSERT_EQ(first.size(), 1);
+  ASSERT_EQ(second.size(), 1);
+}
+
+TEST_F(client_test, should_route_reads_to_replica_until_client_writes) {
+  auto settings = *services.get<repository::connection_settings>();
+  // primary serves as its own replica, connections are told apart by their ids
+  settings.replica_connection_string = settings.connection_string;
+  settings.replica_lag = std::chrono::minutes(1);
+  auto client = create_client(settings);
+  auto connection_id = [&client](repository::read_route route) {
+    return client->select<user>("select unhex(lpad(hex(connection_id()), 32, '0')) as id", route).to_vector().at(0).id;
+  };
+
+  auto primary_id = connection_id(repository::read_route::primary);
+  ASSERT_NE(connection_id(repository::read_route::replica), primary_id);
+
+  client->create(user{.id = guid(ROUTED_USER_ID)});
+
+  ASSERT_EQ(connection_id(repository::read_route::replica), primary_id);
+}
@@ -0,0 +1,37 @@
+//
+// Created by Daniil Ryzhkov on 17/10/2026.
+//
+
+#include "base_repository_benchmark.hpp"
+
+using namespace repository::models;
+
+#define BENCHMARK_QUERIES 500
+
+class connection_pool_benchmark : public base_repository_benchmark {
+ protected:
+  // Returns users read by the queries as work.
+  benchmark::measurement measure_query_latency(std::chrono::milliseconds validation_interval) {
+    auto settings = *services.get<const repository::connection_settings>();
+    settings.validation_interval = validation_interval;
+    auto pool = std::make_shared<repository::connection_pool>(settings);
+    repository::client<std::shared_ptr<repository::connection_pool>, std::shared_ptr<repository::replica_pool>> client(pool, nullptr);
+    client.get_connection()->setSchema(get_connection()->getSchema());
+
+    return benchmark::measure<std::micro>(BENCHMARK_QUERIES, [&client]() {
+      return client.select<user>("select * from users where id = ?")
+          .with_param(guid(DEFAULT_USER_ID))
+          .all()
+          ->size();
+    });
+  }
+};
+
+TEST_F(connection_pool_benchmark, per_query_latency) {
+  // zero interval pings the server before every statement, as the single connection client did
+  auto validating = measure_query_latency(std::chrono::milliseconds(0));
+  auto pooled = measure_query_latency(std::chrono::seconds(1));
+
+  ASSERT_EQ(pooled.work, BENCHMARK_QUERIES);
+  benchmark::compare("Per query latency validating every query vs after idle time", "us", validating, pooled);
+}
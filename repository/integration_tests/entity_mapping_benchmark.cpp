@@ -0,0 +1,137 @@
+//
+// Created by Daniil Ryzhkov on 17/10/2026.
+//
+
+#include <mariadb/conncpp/ResultSet.hpp>
+#include <lambda/string_utils.hpp>
+
+#include "base_repository_benchmark.hpp"
+
+using namespace repository::models;
+
+#define BENCHMARK_ROWS 2000
+#define BENCHMARK_ROUNDS 20
+#define RECEIPT_ID "7c9e6679-7425-40de-944b-000000000001"
+
+// Copy of the former mapping as the baseline: a heap allocated property with virtual setter per column,
+// each reading its column by name on every row.
+class by_name_property {
+ public:
+  explicit by_name_property(std::string column_name) : m_column_name(std::move(column_name)) {}
+  virtual ~by_name_property() = default;
+
+  virtual void set_entity_property(receipt_item &item, sql::ResultSet *res) = 0;
+
+ protected:
+  std::string m_column_name;
+};
+
+template<typename TProperty>
+class by_name_property_of : public by_name_property {
+ public:
+  by_name_property_of(std::string column_name, TProperty receipt_item::*member)
+      : by_name_property(std::move(column_name)), m_member(member) {}
+
+  void set_entity_property(receipt_item &item, sql::ResultSet *res) override {
+    if constexpr (std::is_same_v<TProperty, int>) {
+      item.*m_member = res->getInt(m_column_name);
+    } else {
+      auto s = res->getString(m_column_name);
+      std::string_view value(s.c_str(), s.length());
+      if constexpr (std::is_same_v<TProperty, guid>) {
+        item.*m_member = guid::from_bytes(value);
+      } else if constexpr (std::is_same_v<TProperty, money>) {
+        item.*m_member = money::parse(value);
+      } else {
+        item.*m_member = std::string(value);
+      }
+    }
+  }
+
+ private:
+  TProperty receipt_item::*m_member;
+};
+
+static std::vector<std::unique_ptr<by_name_property>> create_by_name_properties() {
+  std::vector<std::unique_ptr<by_name_property>> properties;
+  properties.push_back(std::make_unique<by_name_property_of<guid>>("id", &receipt_item::id));
+  properties.push_back(std::make_unique<by_name_property_of<guid>>("receipt_id", &receipt_item::receipt_id));
+  properties.push_back(std::make_unique<by_name_property_of<std::string>>("description", &receipt_item::description));
+  properties.push_back(std::make_unique<by_name_property_of<money>>("amount", &receipt_item::amount));
+  properties.push_back(std::make_unique<by_name_property_of<std::string>>("category", &receipt_item::category));
+  properties.push_back(std::make_unique<by_name_property_of<int>>("sort_order", &receipt_item::sort_order));
+  return properties;
+}
+
+// Sum over the read columns, equal only if both paths read the same values.
+static size_t checksum(const receipt_item &item) {
+  return !item.id.is_nil() + !item.receipt_id.is_nil() + item.description.size() + item.category.size()
+      + (size_t) item.amount.cents() + (size_t) item.sort_order;
+}
+
+class entity_mapping_benchmark : public base_repository_benchmark {
+ protected:
+  void SetUp() override {
+    base_repository_benchmark::SetUp();
+    auto client = services.get<repository::t_client>();
+    receipt r;
+    r.id = guid(RECEIPT_ID);
+    r.user_id = guid(DEFAULT_USER_ID);
+    r.date = "2024-06-22";
+    r.total_amount = money::from_cents(100);
+    r.currency = "EUR";
+    r.store_name = "store_name";
+    r.category = "category";
+    r.state = receipt::done;
+    client->create(r);
+    std::vector<receipt_item> items;
+    items.reserve(BENCHMARK_ROWS);
+    for (int i = 0; i < BENCHMARK_ROWS; i++) {
+      items.push_back({guid::parse(lambda::string::format("7c9e6679-7425-40de-944c-%012d", i)), guid(RECEIPT_ID), "description", money::from_cents(100), "category", i});
+    }
+    client->create_many<receipt_item>(items);
+  }
+
+  // Executes the query outside of the measured time, only mapping of the rows is measured.
+  template<typename TMap>
+  benchmark::measurement measure_mapping(TMap &&map) {
+    auto connection = get_connection();
+    auto execute = [&connection]() {
+      std::unique_ptr<sql::Statement> stmt(connection->createStatement());
+      return std::unique_ptr<sql::ResultSet>(stmt->executeQuery("select * from receipt_items"));
+    };
+    return benchmark::measure<std::milli>(BENCHMARK_ROUNDS, execute, [&map](auto &result) {
+      size_t sum = 0;
+      size_t rows = 0;
+      map(result.get(), [&](const receipt_item &item) {
+        sum += checksum(item);
+        rows++;
+      });
+      EXPECT_EQ(rows, BENCHMARK_ROWS);
+      return sum;
+    });
+  }
+};
+
+TEST_F(entity_mapping_benchmark, get_entity_throughput) {
+  auto properties = create_by_name_properties();
+  auto by_name = measure_mapping([&properties](sql::ResultSet *result, auto &&visit) {
+    while (result->next()) {
+      auto item = std::make_shared<receipt_item>();
+      for (auto &property : properties) {
+        property->set_entity_property(*item, result);
+      }
+      visit(*item);
+    }
+  });
+
+  auto configuration = repository::configurations::repository_configuration<receipt_item>();
+  auto by_plan = measure_mapping([&configuration](sql::ResultSet *result, auto &&visit) {
+    auto plan = configuration.get_column_plan(result);
+    while (result->next()) {
+      visit(*configuration.get_entity(result, plan));
+    }
+  });
+
+  benchmark::compare("Mapping receipt items by name vs by column plan", "ms", by_name, by_plan);
+}
@@ -0,0 +1,47 @@
+//
+// Created by Daniil Ryzhkov on 17/10/2026.
+//
+
+#include <unordered_set>
+
+#include <gtest/gtest.h>
+
+#include "repository/models/guid.hpp"
+
+using namespace repository::models;
+
+#define TEST_GUID "d394a832-4011-7023-c519-afe3adaf0233"
+
+TEST(guid_test, should_format_parsed_guid) {
+  auto id = guid::parse(TEST_GUID);
+  ASSERT_EQ(id.str(), TEST_GUID);
+  ASSERT_EQ(guid::parse("D394A832-4011-7023-C519-AFE3ADAF0233"), id);
+  ASSERT_EQ(std::string_view(id.data(), 4), "\xd3\x94\xa8\x32");
+  ASSERT_EQ(guid::from_bytes(std::string_view(id.data(), guid::SIZE)), id);
+}
+
+TEST(guid_test, should_reject_invalid_text) {
+  guid id;
+  ASSERT_FALSE(guid::try_parse("", id));
+  ASSERT_FALSE(guid::try_parse("user_id", id));
+  ASSERT_FALSE(guid::try_parse("d394a832-4011-7023-c519-afe3adaf023", id));
+  ASSERT_FALSE(guid::try_parse("d394a832-4011-7023-c519-afe3adaf02333", id));
+  ASSERT_FALSE(guid::try_parse("d394a832+4011-7023-c519-afe3adaf0233", id));
+  ASSERT_FALSE(guid::try_parse("d394a832-4011-7023-c519-afe3adaf023g", id));
+  ASSERT_FALSE(guid::try_parse("d394a832-4011-7023-c519-afe3adaf023 ", id));
+  ASSERT_TRUE(id.is_nil());
+  ASSERT_THROW(guid("receipt_1"), std::invalid_argument);
+  ASSERT_THROW(guid::from_bytes("too short"), std::invalid_argument);
+}
+
+TEST(guid_test, should_compare_and_hash_by_bytes) {
+  guid first("00000000-0000-4000-8000-000000000001");
+  guid second("00000000-0000-4000-8000-000000000002");
+  ASSERT_LT(guid(), first);
+  ASSERT_LT(first, second);
+  ASSERT_NE(first, second);
+
+  std::unordered_set<guid> ids{first, second, guid(TEST_GUID)};
+  ASSERT_EQ(ids.size(), 3);
+  ASSERT_TRUE(ids.contains(guid::parse("D394A832-4011-7023-C519-AFE3ADAF0233")));
+}
@@ -0,0 +1,51 @@
+//
+// Created by Daniil Ryzhkov on 17/10/2026.
+//
+
+#include <gtest/gtest.h>
+
+#include "repository/models/money.hpp"
+
+using namespace repository::models;
+
+TEST(money_test, should_parse_decimal_text) {
+  ASSERT_EQ(money::parse("123.45").cents(), 12345);
+  ASSERT_EQ(money::parse("123.4").cents(), 12340);
+  ASSERT_EQ(money::parse("123").cents(), 12300);
+  ASSERT_EQ(money::parse("-0.05").cents(), -5);
+  ASSERT_EQ(money::parse("0.00"), money());
+
+  money value;
+  ASSERT_FALSE(money::try_parse("", value));
+  ASSERT_FALSE(money::try_parse("-", value));
+  ASSERT_FALSE(money::try_parse(".5", value));
+  ASSERT_FALSE(money::try_parse("1.", value));
+  ASSERT_FALSE(money::try_parse("1.234", value));
+  ASSERT_FALSE(money::try_parse("1,23", value));
+  ASSERT_FALSE(money::try_parse("1.-2", value));
+  ASSERT_FALSE(money::try_parse("--1", value));
+  ASSERT_FALSE(money::try_parse("99999999999999999999", value));
+  ASSERT_TRUE(value.is_zero());
+  ASSERT_THROW(money::parse("EUR 1.00"), std::invalid_argument);
+}
+
+TEST(money_test, should_format_two_decimals) {
+  ASSERT_EQ(money().str(), "0.00");
+  ASSERT_EQ(money::from_cents(5).str(), "0.05");
+  ASSERT_EQ(money::from_cents(-12345).str(), "-123.45");
+  ASSERT_EQ(money::from_cents(INT64_MIN).str(), "-92233720368547758.08");
+  ASSERT_EQ(money::parse(money::from_cents(100000).str()).cents(), 100000);
+}
+
+TEST(money_test, should_add_cents_exactly) {
+  auto total = money();
+  for (int i = 0; i < 10; i++) {
+    total += money::from_floating(0.1);
+  }
+  ASSERT_EQ(total, money::from_cents(100));
+  ASSERT_EQ(money::from_cents(199) * 3, money::from_cents(597));
+  ASSERT_LT(money::from_cents(-1), money());
+  ASSERT_EQ(money::from_floating(12.34L).cents(), 1234);
+  ASSERT_EQ(money::from_floating(-0.999).cents(), -100);
+  ASSERT_EQ(money::from_cents(1234).to_floating<long double>(), 12.34L);
+}
@@ -20,17 +20,28 @@ class receipt_repository_test : public base_repository_integration_test {
   container<
       singleton<Aws::Client::ClientConfiguration>,
       singleton<repository::connection_settings>,
+      singleton<repository::connection_pool>,
+      singleton<repository::replica_pool>,
       scoped<repository::t_client, repository::client<>>,
       transient<repository::t_receipt_repository, repository::receipt_repository<>>
   > services;
 };
 
+// Test ids are numbered, receipts and their items apart.
+static guid receipt_id(int number) {
+  return guid::parse(lambda::string::format("7c9e6679-7425-40de-944b-%012d", number));
+}
+
+static guid item_id(int number) {
+  return guid::parse(lambda::string::format("7c9e6679-7425-40de-944c-%012d", number));
+}
+
 static receipt create_receipt() {
   receipt r;
-  r.id = "12345";
-  r.user_id = DEFAULT_USER_ID;
+  r.id = receipt_id(12345);
+  r.user_id = guid(DEFAULT_USER_ID);
   r.date = "2024-06-22";
-  r.total_amount = 1.0;
+  r.total_amount = money::from_cents(100);
   r.currency = "EUR";
   r.store_name = "store_name";
   r.category = "category";
@@ -63,18 +74,18 @@ TEST_F(receipt_repository_test, should_update_receipt) {
 TEST_F(receipt_repository_test, should_create_receipt_items) {
   auto receipt_repository = services.get<repository::t_receipt_repository>();
   auto r = create_receipt();
-  r.items.push_back({ "item_id", r.id, "description", 1.0, "category", 0 });
+  r.items.push_back({ item_id(0), r.id, "description", money::from_cents(100), "category", 0 });
   receipt_repository->store(r);
   auto repo = services.get<repository::t_client>();
   auto items = repo->select<receipt_item>("select * from receipt_items where receipt_id = ?").with_param(r.id).all();
   ASSERT_EQ(1, items->size());
-  ASSERT_EQ("item_id", items->operator[](0)->id);
+  ASSERT_EQ(item_id(0), items->operator[](0)->id);
 }
 
 TEST_F(receipt_repository_test, should_delete_old_items) {
   auto receipt_repository = services.get<repository::t_receipt_repository>();
   auto r = create_receipt();
-  r.items.push_back({ "item_id", r.id, "description", 1.0, "category", 0 });
+  r.items.push_back({ item_id(0), r.id, "description", money::from_cents(100), "category", 0 });
   receipt_repository->store(r);
   r.items.clear();
   r.version++;
@@ -87,21 +98,21 @@ TEST_F(receipt_repository_test, should_delete_old_items) {
 TEST_F(receipt_repository_test, should_maintain_items_order) {
   auto receipt_repository = services.get<repository::t_receipt_repository>();
   auto r = create_receipt();
-  r.items.push_back({ "item_id_1", r.id, "description", 1.0, "category", 0 });
-  r.items.push_back({ "item_id_2", r.id, "description", 1.0, "category", -1 });
+  r.items.push_back({ item_id(1), r.id, "description", money::from_cents(100), "category", 0 });
+  r.items.push_back({ item_id(2), r.id, "description", money::from_cents(100), "category", -1 });
   receipt_repository->store(r);
   auto repo = services.get<repository::t_client>();
   auto items = repo->select<receipt_item>("select * from receipt_items where receipt_id = ? order by sort_order").with_param(r.id).all();
   ASSERT_EQ(2, items->size());
-  ASSERT_EQ("item_id_1", items->operator[](0)->id);
-  ASSERT_EQ("item_id_2", items->operator[](1)->id);
+  ASSERT_EQ(item_id(1), items->operator[](0)->id);
+  ASSERT_EQ(item_id(2), items->operator[](1)->id);
 }
 
 TEST_F(receipt_repository_test, should_find_receipt_by_image_name) {
   auto receipt_repository = services.get<repository::t_receipt_repository>();
   auto r = create_receipt();
   receipt_repository->store(r);
-  auto receipt = receipt_repository->get(DEFAULT_USER_ID, "image_name");
+  auto receipt = receipt_repository->get(guid(DEFAULT_USER_ID), "image_name");
   ASSERT_TRUE(receipt.has_value());
   ASSERT_EQ(r.id, receipt.get_value().id);
 }
@@ -110,7 +121,7 @@ TEST_F(receipt_repository_test, should_not_find_receipt_if_image_name_does_not_m
   auto receipt_repository = services.get<repository::t_receipt_repository>();
   auto r = create_receipt();
   receipt_repository->store(r);
-  auto receipt = receipt_repository->get(DEFAULT_USER_ID, "file_name");
+  auto receipt = receipt_repository->get(guid(DEFAULT_USER_ID), "file_name");
   ASSERT_FALSE(receipt.has_value());
 }
 
@@ -165,3 +176,120 @@ TEST_F(receipt_repository_test, should_generate_concurrency_conflict_if_storing_
     FAIL() << "Expected an exception";
   } catch (const std::exception &e) {}
 }
+
+TEST_F(receipt_repository_test, should_create_many_receipt_items) {
+  auto receipt_repository = services.get<repository::t_receipt_repository>();
+  auto r = create_receipt();
+  for (int i = 0; i < 100; i++) {
+    r.items.push_back({ item_id(i), r.id, "description", money::from_cents(100), "category", 0 });
+  }
+  receipt_repository->store(r);
+  auto repo = services.get<repository::t_client>();
+  auto items = repo->select<receipt_item>("select * from receipt_items where receipt_id = ? order by sort_order").with_param(r.id).all();
+  ASSERT_EQ(100, items->size());
+  for (int i = 0; i < 100; i++) {
+    ASSERT_EQ(item_id(i), items->operator[](i)->id);
+    ASSERT_EQ(i, items->operator[](i)->sort_order);
+  }
+}
+
+TEST_F(receipt_repository_test, should_get_receipts_by_month) {
+  auto receipt_repository = services.get<repository::t_receipt_repository>();
+  auto r1 = create_receipt();
+  r1.id = receipt_id(1);
+  r1.image_name = "image_1";
+  r1.date = "2024-12-31";
+  receipt_repository->store(r1);
+  auto r2 = create_receipt();
+  r2.id = receipt_id(2);
+  r2.image_name = "image_2";
+  r2.date = "2025-01-01";
+  receipt_repository->store(r2);
+
+  auto december = receipt_repository->get_by_month(guid(DEFAULT_USER_ID), 2024, 12);
+  ASSERT_EQ(1, december.size());
+  ASSERT_EQ(receipt_id(1), december[0].id);
+
+  auto january = receipt_repository->get_by_month(guid(DEFAULT_USER_ID), 2025, 1);
+  ASSERT_EQ(1, january.size());
+  ASSERT_EQ(receipt_id(2), january[0].id);
+}
+
+TEST_F(receipt_repository_test, should_get_receipt_with_ordered_items) {
+  auto receipt_repository = services.get<repository::t_receipt_repository>();
+  auto r = create_receipt();
+  r.items.push_back({ item_id(1), r.id, "description_1", money::from_cents(100), "category_1", 0 });
+  r.items.push_back({ item_id(2), r.id, "description_2", money::from_cents(200), "category_2", 0 });
+  receipt_repository->store(r);
+
+  auto by_id = receipt_repository->get(r.id);
+  ASSERT_TRUE(by_id.has_value());
+  ASSERT_EQ("store_name", by_id.get_value().store_name);
+  ASSERT_EQ(2, by_id.get_value().items.size());
+  ASSERT_EQ(item_id(1), by_id.get_value().items[0].id);
+  ASSERT_EQ("category_1", by_id.get_value().items[0].category);
+  ASSERT_EQ(item_id(2), by_id.get_value().items[1].id);
+  ASSERT_EQ(1, by_id.get_value().items[1].sort_order);
+
+  auto by_image = receipt_repository->get(guid(DEFAULT_USER_ID), "image_name");
+  ASSERT_TRUE(by_image.has_value());
+  ASSERT_EQ(2, by_image.get_value().items.size());
+}
+
+TEST_F(receipt_repository_test, should_get_receipt_without_items) {
+  auto receipt_repository = services.get<repository::t_receipt_repository>();
+  auto r = create_receipt();
+  receipt_repository->store(r);
+
+  auto stored = receipt_repository->get(r.id);
+  ASSERT_TRUE(stored.has_value());
+  ASSERT_EQ(0, stored.get_value().items.size());
+}
+
+TEST_F(receipt_repository_test, should_upsert_receipt_with_newer_version_only) {
+  auto repo = services.get<repository::t_client>();
+  auto r = create_receipt();
+  repo->upsert(r);
+
+  r.store_name = "new_store_name";
+  r.version = 1;
+  repo->upsert(r);
+  ASSERT_EQ("new_store_name", repo->get<receipt>(r.id)->store_name);
+
+  r.store_name = "stale_store_name";
+  ASSERT_THROW(repo->upsert(r), repository::concurrency_exception);
+  auto stored_receipt = repo->get<receipt>(r.id);
+  ASSERT_EQ(1, stored_receipt->version);
+  ASSERT_EQ("new_store_name", stored_receipt->store_name);
+}
+
+TEST_F(receipt_repository_test, should_get_changed_receipts_by_pages) {
+  auto receipt_repository = services.get<repository::t_receipt_repository>();
+  for (int i = 1; i <= 3; i++) {
+    auto r = create_receipt();
+    r.id = receipt_id(i);
+    r.image_name = "image_" + std::to_string(i);
+    r.items.push_back({ item_id(i), r.id, "description", money::from_cents(100), "category", 0 });
+    receipt_repository->store(r);
+  }
+  auto deleted = create_receipt();
+  deleted.id = receipt_id(1);
+  deleted.image_name = "image_1";
+  receipt_repository->drop(deleted);
+
+  auto first_page = receipt_repository->get_changed(guid(DEFAULT_USER_ID), 0, 2);
+  ASSERT_EQ(2, first_page.size());
+  ASSERT_EQ(receipt_id(2), first_page[0].id);
+  ASSERT_EQ(1, first_page[0].items.size());
+  ASSERT_EQ(receipt_id(3), first_page[1].id);
+  ASSERT_LT(first_page[0].change_seq, first_page[1].change_seq);
+
+  auto second_page = receipt_repository->get_changed(guid(DEFAULT_USER_ID), first_page[1].change_seq, 2);
+  ASSERT_EQ(1, second_page.size());
+  ASSERT_EQ(receipt_id(1), second_page[0].id);
+  ASSERT_TRUE(second_page[0].is_deleted);
+  ASSERT_TRUE(second_page[0].items.empty());
+
+  auto last_page = receipt_repository->get_changed(guid(DEFAULT_USER_ID), second_page[0].change_seq, 2);
+  ASSERT_TRUE(last_page.empty());
+}
@@ -3,33 +3,68 @@
 //
 
 #include <repository/base_query.hpp>
+#include <repository/configurations/common/column_configuration.hpp>
 
 namespace repository {
 
-base_query::base_query(std::shared_ptr<sql::PreparedStatement> stmt) : m_stmt(std::move(stmt)) {}
+base_query::base_query(std::shared_ptr<sql::PreparedStatement> stmt, query_metrics *metrics, std::string_view query)
+    : m_stmt(std::move(stmt)), m_metrics(metrics), m_query(metrics ? query : std::string_view()) {}
 
 void base_query::set_param(int t) {
   m_stmt->setInt(m_param_index++, t);
+  m_parameters.push_back({'i'});
 }
 
 void base_query::set_param(double t) {
   m_stmt->setDouble(m_param_index++, t);
+  m_parameters.push_back({'d'});
 }
 
 void base_query::set_param(long t) {
   m_stmt->setInt64(m_param_index++, t);
+  m_parameters.push_back({'l'});
 }
 
 void base_query::set_param(const std::string &t) {
   m_stmt->setString(m_param_index++, t);
+  m_parameters.push_back({'s', t.length()});
 }
 
-void base_query::set_param(long double t) {
-  m_stmt->setDouble(m_param_index++, (double) t);
+void base_query::set_param(const models::money &t) {
+  configurations::common::bind(*m_stmt, m_param_index++, t);
+  m_parameters.push_back({'m'});
+}
+
+void base_query::set_param(const models::guid &t) {
+  configurations::common::bind(*m_stmt, m_param_index++, t);
+  m_parameters.push_back({'g', models::guid::SIZE});
 }
 
 std::shared_ptr<sql::PreparedStatement> base_query::get_stmt() {
   return m_stmt;
 }
 
+std::unique_ptr<sql::ResultSet> base_query::execute_query() {
+  stopwatch timer;
+  std::unique_ptr<sql::ResultSet> result(m_stmt->executeQuery());
+  if (m_metrics) {
+    m_metrics->record_execute(m_query, timer.elapsed(), m_parameters);
+  }
+  return result;
+}
+
+void base_query::execute() {
+  stopwatch timer;
+  m_stmt->execute();
+  if (m_metrics) {
+    m_metrics->record_execute(m_query, timer.elapsed(), m_parameters);
+  }
+}
+
+void base_query::record_rows(size_t rows) {
+  if (m_metrics) {
+    m_metrics->record_rows(m_query, rows);
+  }
+}
+
 }
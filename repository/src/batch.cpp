@@ -0,0 +1,73 @@
+//
+// Created by Daniil Ryzhkov on 17/10/2026.
+//
+
+#include <repository/batch.hpp>
+
+namespace repository {
+
+batch &batch::add(std::string_view query) {
+  if (m_size > 0) {
+    m_query += "; ";
+  }
+  m_query += query;
+  m_size++;
+  return *this;
+}
+
+batch &batch::with_param(int t) {
+  m_binders.emplace_back([t](sql::PreparedStatement &stmt, int32_t index) {
+    stmt.setInt(index, t);
+    return index + 1;
+  });
+  return *this;
+}
+
+batch &batch::with_param(double t) {
+  m_binders.emplace_back([t](sql::PreparedStatement &stmt, int32_t index) {
+    stmt.setDouble(index, t);
+    return index + 1;
+  });
+  return *this;
+}
+
+batch &batch::with_param(long t) {
+  m_binders.emplace_back([t](sql::PreparedStatement &stmt, int32_t index) {
+    stmt.setInt64(index, t);
+    return index + 1;
+  });
+  return *this;
+}
+
+batch &batch::with_param(const std::string &t) {
+  m_binders.emplace_back([t](sql::PreparedStatement &stmt, int32_t index) {
+    stmt.setString(index, t);
+    return index + 1;
+  });
+  return *this;
+}
+
+batch &batch::with_param(const models::money &t) {
+  m_binders.emplace_back([t](sql::PreparedStatement &stmt, int32_t index) {
+    configurations::common::bind(stmt, index, t);
+    return index + 1;
+  });
+  return *this;
+}
+
+batch &batch::with_param(const models::guid &t) {
+  m_binders.emplace_back([t](sql::PreparedStatement &stmt, int32_t index) {
+    configurations::common::bind(stmt, index, t);
+    return index + 1;
+  });
+  return *this;
+}
+
+void batch::bind(sql::PreparedStatement &stmt) const {
+  int32_t index = 1;
+  for (const auto &binder : m_binders) {
+    index = binder(stmt, index);
+  }
+}
+
+}
@@ -4,6 +4,7 @@
 
 #include <lambda/string_utils.hpp>
 #include <aws/ssm/model/GetParameterRequest.h>
+#include <aws/ssm/SSMErrors.h>
 
 using namespace repository;
 using namespace lambda;
@@ -29,3 +30,73 @@ std::string repository::get_connection_string(const std::string &stage, const Aw
   }
   return outcome.GetResult().GetParameter().GetValue();
 }
+
+std::string repository::get_replica_connection_string(const std::string &stage, const Aws::Client::ClientConfiguration &config) {
+  auto conn_env = getenv("DB_REPLICA_CONNECTION_STRING");
+  if (conn_env != nullptr) {
+    return conn_env;
+  }
+  // primary configured by environment has a replica only if it is configured the same way
+  if (getenv("DB_CONNECTION_STRING") != nullptr) {
+    return "";
+  }
+
+  std::string ssmPrefix = string::format("/receipt-scan/%s", stage.c_str());
+  Aws::SSM::SSMClient ssmClient(config);
+  Aws::SSM::Model::GetParameterRequest connStrReq;
+  connStrReq
+      .WithName(string::format("%s/db-replica-connection-string", ssmPrefix.c_str()))
+      .WithWithDecryption(true);
+  Aws::SSM::Model::GetParameterOutcome outcome =
+      ssmClient.GetParameter(connStrReq);
+  if (!outcome.IsSuccess()) {
+    if (outcome.GetError().GetErrorType() == Aws::SSM::SSMErrors::PARAMETER_NOT_FOUND) {
+      lambda::log.info("Read replica is not configured, reads are served by the primary");
+      return "";
+    }
+    throw std::runtime_error(
+        string::format("Error occurred while obtaining parameter from ssm: %s",
+                   outcome.GetError().GetMessage().c_str()));
+  }
+  return outcome.GetResult().GetParameter().GetValue();
+}
+
+std::chrono::milliseconds repository::get_replica_lag() {
+  auto lag_env = getenv("DB_REPLICA_LAG_MS");
+  if (lag_env == nullptr) {
+    return std::chrono::seconds(1);
+  }
+  return std::chrono::milliseconds(std::stol(lag_env));
+}
+
+size_t repository::get_pool_size() {
+  auto pool_size_env = getenv("DB_POOL_SIZE");
+  if (pool_size_env == nullptr) {
+    return 1;
+  }
+  return std::stoul(pool_size_env);
+}
+
+std::chrono::milliseconds repository::get_validation_interval() {
+  auto interval_env = getenv("DB_VALIDATION_INTERVAL_MS");
+  if (interval_env == nullptr) {
+    return std::chrono::seconds(1);
+  }
+  return std::chrono::milliseconds(std::stol(interval_env));
+}
+
+std::chrono::milliseconds repository::get_slow_query_threshold() {
+  auto threshold_env = getenv("DB_SLOW_QUERY_MS");
+  if (threshold_env == nullptr) {
+    return std::chrono::milliseconds(100);
+  }
+  return std::chrono::milliseconds(std::stol(threshold_env));
+}
+
+size_t repository::get_statement_cache_size() {
+  auto cache_size_env = getenv("DB_STATEMENT_CACHE_SIZE");
+  if (cache_size_env == nullptr) {
+    return 64;
+  }
+  return std::stoul(cache_size_env);
+}
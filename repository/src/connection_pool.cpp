@@ -0,0 +1,206 @@
+//
+// Created by Daniil Ryzhkov on 17/10/2026.
+//
+
+#include <repository/connection_pool.hpp>
+
+#include <mariadb/conncpp/DriverManager.hpp>
+#include <mariadb/conncpp/PreparedStatement.hpp>
+#include <mariadb/conncpp/ResultSet.hpp>
+#include <mariadb/conncpp/Statement.hpp>
+
+#include <lambda/log.hpp>
+
+namespace repository {
+
+connection_lease::connection_lease(connection_pool *pool, std::unique_ptr<pooled_connection> entry)
+    : m_pool(pool), m_entry(std::move(entry)) {}
+
+connection_lease::~connection_lease() {
+  release();
+}
+
+connection_lease::connection_lease(connection_lease &&other) noexcept
+    : m_pool(other.m_pool), m_entry(std::move(other.m_entry)) {
+  other.m_pool = nullptr;
+}
+
+connection_lease &connection_lease::operator=(connection_lease &&other) noexcept {
+  if (this != &other) {
+    release();
+    m_pool = other.m_pool;
+    m_entry = std::move(other.m_entry);
+    other.m_pool = nullptr;
+  }
+  return *this;
+}
+
+const std::shared_ptr<sql::Connection> &connection_lease::get() {
+  if (!m_entry) {
+    throw std::runtime_error("Connection lease is empty!");
+  }
+  m_pool->validate(*m_entry);
+  m_entry->last_used = std::chrono::steady_clock::now();
+  return m_entry->connection;
+}
+
+std::shared_ptr<sql::PreparedStatement> connection_lease::prepare(std::string_view query) {
+  auto &connection = get();
+  return m_entry->statements.prepare(*connection, query);
+}
+
+std::shared_ptr<sql::PreparedStatement> connection_lease::prepare_uncached(std::string_view query) {
+  auto &connection = get();
+  return statement_cache::prepare_uncached(*connection, query);
+}
+
+statement_cache_stats connection_lease::get_statement_cache_stats() const {
+  if (!m_entry) {
+    return {};
+  }
+  return m_entry->statements.get_stats();
+}
+
+size_t connection_lease::get_max_allowed_packet() {
+  auto &connection = get();
+  if (m_entry->max_allowed_packet == 0) {
+    std::unique_ptr<sql::Statement> stmt(connection->createStatement());
+    std::unique_ptr<sql::ResultSet> result(stmt->executeQuery("select @@max_allowed_packet"));
+    if (!result->next()) {
+      throw std::runtime_error("Unable to obtain max_allowed_packet!");
+    }
+    m_entry->max_allowed_packet = result->getUInt64(1);
+  }
+  return m_entry->max_allowed_packet;
+}
+
+void connection_lease::invalidate() {
+  if (m_entry) {
+    m_entry->needs_validation = true;
+  }
+}
+
+void connection_lease::release() {
+  if (m_pool && m_entry) {
+    m_pool->release(std::move(m_entry));
+  }
+  m_pool = nullptr;
+}
+
+connection_pool::connection_pool(const connection_settings &settings)
+    : connection_pool(settings, settings.connection_string) {}
+
+connection_pool::connection_pool(const connection_settings &settings, std::string connection_string)
+    : m_connection_string(std::move(connection_string)),
+      m_size(settings.pool_size > 0 ? settings.pool_size : 1),
+      m_validation_interval(settings.validation_interval),
+      m_statement_cache_size(settings.statement_cache_size),
+      m_slow_query_threshold(settings.slow_query_threshold) {
+  m_idle.reserve(m_size);
+}
+
+connection_pool::~connection_pool() {
+  std::lock_guard lock(m_mutex);
+  for (auto &entry : m_idle) {
+    if (entry->connection) {
+      lambda::log.info("Closing connection with the database...");
+      entry->connection->close();
+    }
+  }
+}
+
+connection_lease connection_pool::acquire() {
+  std::unique_lock lock(m_mutex);
+  m_available.wait(lock, [this] { return !m_idle.empty() || m_open < m_size; });
+  return take(lock);
+}
+
+connection_lease connection_pool::try_acquire() {
+  std::unique_lock lock(m_mutex);
+  if (m_idle.empty() && m_open >= m_size) {
+    return {};
+  }
+  return take(lock);
+}
+
+connection_lease connection_pool::take(std::unique_lock<std::mutex> &lock) {
+  if (!m_idle.empty()) {
+    // most recently returned connection is the least likely to be stale
+    auto entry = std::move(m_idle.back());
+    m_idle.pop_back();
+    return {this, std::move(entry)};
+  }
+
+  m_open++;
+  lock.unlock();
+
+  auto entry = std::make_unique<pooled_connection>(m_statement_cache_size);
+  try {
+    lambda::log.info("Establishing connection with the database...");
+    entry->connection = create_connection();
+    entry->last_used = std::chrono::steady_clock::now();
+  } catch (std::exception &e) {
+    lambda::log.error(
+        "Error occurred while establishing connection with the database: %s",
+        e.what());
+    lock.lock();
+    m_open--;
+    lock.unlock();
+    m_available.notify_one();
+    throw;
+  }
+  return {this, std::move(entry)};
+}
+
+void connection_pool::release(std::unique_ptr<pooled_connection> entry) {
+  {
+    std::lock_guard lock(m_mutex);
+    m_idle.push_back(std::move(entry));
+  }
+  m_available.notify_one();
+}
+
+void connection_pool::validate(pooled_connection &entry) {
+  auto idle = std::chrono::steady_clock::now() - entry.last_used;
+  if (entry.connection && !entry.needs_validation && idle < m_validation_interval) {
+    return;
+  }
+
+  if (!entry.connection || entry.connection->isClosed() || !entry.connection->isValid()) {
+    std::string prev_schema;
+    if (entry.connection) {
+      try {
+        prev_schema = entry.connection->getSchema();
+      } catch (std::exception &e) {
+        lambda::log.info("Unable to obtain schema of lost connection: %s", e.what());
+      }
+    }
+    lambda::log.info("Reconnecting to the database...");
+    m_reconnects++;
+    entry.statements.clear();
+    entry.connection = create_connection();
+    if (!prev_schema.empty()) {
+      entry.connection->setSchema(prev_schema);
+    }
+  }
+  entry.needs_validation = false;
+}
+
+std::unique_ptr<sql::Connection> connection_pool::create_connection() {
+  sql::SQLString url(m_connection_string);
+  // report changed rows instead of found rows, so that upsert keeping the stored row affects none;
+  // multi-statement queries are used by batches of prepared statements
+  sql::Properties properties({
+      {"useAffectedRows", "true"},
+      {"allowMultiQueries", "true"},
+  });
+  std::unique_ptr<sql::Connection> conn(sql::DriverManager::getConnection(url, properties));
+  if (conn == nullptr) {
+    lambda::log.error("Unable to establish connection with database!");
+    throw std::runtime_error("Unable to establish connection with database!");
+  }
+  std::unique_ptr<sql::PreparedStatement>(conn->prepareStatement("set time_zone = '+00:00'"))->execute();
+  return std::move(conn);
+}
+
+}
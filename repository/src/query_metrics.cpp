@@ -0,0 +1,242 @@
+//
+// Created by Daniil Ryzhkov on 17/10/2026.
+//
+
+#include <repository/query_metrics.hpp>
+
+#include <algorithm>
+#include <cstdio>
+
+#include <lambda/log.hpp>
+
+namespace repository {
+
+namespace {
+
+// CloudWatch limits length of dimension values
+constexpr size_t MAX_DIMENSION_LENGTH = 250;
+
+void append_escaped(std::string &output, std::string_view value) {
+  output += '"';
+  for (auto c : value) {
+    switch (c) {
+      case '"': output += "\\\""; break;
+      case '\\': output += "\\\\"; break;
+      case '\n': output += "\\n"; break;
+      case '\r': output += "\\r"; break;
+      case '\t': output += "\\t"; break;
+      default:
+        if ((unsigned char) c < 0x20) {
+          char buffer[8];
+          std::snprintf(buffer, sizeof(buffer), "\\u%04x", c);
+          output += buffer;
+        } else {
+          output += c;
+        }
+    }
+  }
+  output += '"';
+}
+
+void append_ms(std::string &output, std::chrono::microseconds duration) {
+  char buffer[32];
+  std::snprintf(buffer, sizeof(buffer), "%.3f", (double) duration.count() / 1000.0);
+  output += buffer;
+}
+
+// Appends histogram as values and counts of its non-empty buckets, valued by mean duration in the bucket.
+void append_histogram(std::string &output, const latency_histogram &histogram) {
+  const auto &buckets = histogram.get_buckets();
+  std::string values, counts;
+  for (size_t i = 0; i < buckets.size(); i++) {
+    if (buckets[i] == 0) continue;
+    if (!values.empty()) {
+      values += ',';
+      counts += ',';
+    }
+    append_ms(values, histogram.get_bucket_mean(i));
+    counts += std::to_string(buckets[i]);
+  }
+  output += R"({"Values":[)" + values + R"(],"Counts":[)" + counts + "]}";
+}
+
+void append_header(std::string &output,
+                   std::string_view metrics_namespace,
+                   std::chrono::system_clock::time_point timestamp,
+                   std::string_view dimensions,
+                   const std::vector<std::pair<std::string_view, std::string_view>> &metrics) {
+  auto ms = std::chrono::duration_cast<std::chrono::milliseconds>(timestamp.time_since_epoch()).count();
+  output += R"({"_aws":{"Timestamp":)" + std::to_string(ms) + R"(,"CloudWatchMetrics":[{"Namespace":)";
+  append_escaped(output, metrics_namespace);
+  output += R"(,"Dimensions":[[)";
+  output += dimensions;
+  output += R"(]],"Metrics":[)";
+  for (size_t i = 0; i < metrics.size(); i++) {
+    if (i > 0) output += ',';
+    output += R"({"Name":")";
+    output += metrics[i].first;
+    output += R"(","Unit":")";
+    output += metrics[i].second;
+    output += R"("})";
+  }
+  output += "]}]}";
+}
+
+std::string format_parameters(const std::vector<parameter_shape> &parameters) {
+  std::string output;
+  for (const auto &p : parameters) {
+    if (!output.empty()) output += ", ";
+    switch (p.type) {
+      case 'i': output += "int"; break;
+      case 'l': output += "long"; break;
+      case 'd': output += "double"; break;
+      case 's': output += "string(" + std::to_string(p.length) + ")"; break;
+      case 'g': output += "guid"; break;
+      case 'm': output += "money"; break;
+      default: output += "?";
+    }
+  }
+  return output;
+}
+
+}
+
+void latency_histogram::record(std::chrono::microseconds duration) {
+  auto bucket = std::lower_bound(BOUNDS.begin(), BOUNDS.end(), duration.count()) - BOUNDS.begin();
+  m_buckets[bucket]++;
+  m_bucket_totals[bucket] += duration;
+  m_count++;
+  m_total += duration;
+  m_max = std::max(m_max, duration);
+}
+
+void latency_histogram::merge(const latency_histogram &other) {
+  for (size_t i = 0; i < m_buckets.size(); i++) {
+    m_buckets[i] += other.m_buckets[i];
+    m_bucket_totals[i] += other.m_bucket_totals[i];
+  }
+  m_count += other.m_count;
+  m_total += other.m_total;
+  m_max = std::max(m_max, other.m_max);
+}
+
+std::chrono::microseconds latency_histogram::get_bucket_mean(size_t bucket) const {
+  if (m_buckets[bucket] == 0) {
+    return std::chrono::microseconds(0);
+  }
+  return m_bucket_totals[bucket] / static_cast<int64_t>(m_buckets[bucket]);
+}
+
+void query_metrics::record_prepare(std::string_view statement, std::chrono::microseconds duration) {
+  get(statement).prepare.record(duration);
+}
+
+void query_metrics::record_execute(std::string_view statement,
+                                   std::chrono::microseconds duration,
+                                   const std::vector<parameter_shape> &parameters) {
+  auto &metrics = get(statement);
+  metrics.executions++;
+  metrics.execute.record(duration);
+  if (duration >= m_slow_query_threshold) {
+    m_slow_queries++;
+    lambda::log.info("Slow query took %.1f ms: %.*s; parameters: [%s]",
+                     (double) duration.count() / 1000.0,
+                     (int) statement.size(), statement.data(),
+                     format_parameters(parameters).c_str());
+  }
+}
+
+void query_metrics::record_rows(std::string_view statement, size_t rows) {
+  get(statement).rows += rows;
+}
+
+std::vector<std::string> query_metrics::to_emf(std::string_view metrics_namespace,
+                                               std::string_view user_id,
+                                               std::chrono::system_clock::time_point timestamp) const {
+  std::vector<std::string> lines;
+  lines.reserve(m_statements.size() + 1);
+
+  size_t executions = 0, rows = 0;
+  std::chrono::microseconds execute_time{0}, prepare_time{0};
+  for (const auto &[statement, metrics] : m_statements) {
+    executions += metrics.executions;
+    rows += metrics.rows;
+    execute_time += metrics.execute.get_total();
+    prepare_time += metrics.prepare.get_total();
+
+    std::vector<std::pair<std::string_view, std::string_view>> declared{
+        {"Executions", "Count"},
+        {"Rows", "Count"},
+    };
+    if (metrics.execute.get_count() > 0) declared.emplace_back("ExecuteTime", "Milliseconds");
+    if (metrics.prepare.get_count() > 0) declared.emplace_back("PrepareTime", "Milliseconds");
+
+    auto &line = lines.emplace_back();
+    append_header(line, metrics_namespace, timestamp, R"("Statement")", declared);
+    line += R"(,"Statement":)";
+    append_escaped(line, statement.substr(0, MAX_DIMENSION_LENGTH));
+    line += R"(,"Executions":)" + std::to_string(metrics.executions);
+    line += R"(,"Rows":)" + std::to_string(metrics.rows);
+    if (metrics.execute.get_count() > 0) {
+      line += R"(,"ExecuteTime":)";
+      append_histogram(line, metrics.execute);
+    }
+    if (metrics.prepare.get_count() > 0) {
+      line += R"(,"PrepareTime":)";
+      append_histogram(line, metrics.prepare);
+    }
+    line += '}';
+  }
+
+  // totals are not dimensioned by user to keep metrics cardinality low, user is a searchable property
+  auto &line = lines.emplace_back();
+  append_header(line, metrics_namespace, timestamp, "", {
+      {"Queries", "Count"},
+      {"Rows", "Count"},
+      {"DbTime", "Milliseconds"},
+      {"PrepareTime", "Milliseconds"},
+      {"Reconnects", "Count"},
+      {"SlowQueries", "Count"},
+  });
+  line += R"(,"UserId":)";
+  append_escaped(line, user_id);
+  line += R"(,"Queries":)" + std::to_string(executions);
+  line += R"(,"Rows":)" + std::to_string(rows);
+  line += R"(,"DbTime":)";
+  append_ms(line, execute_time + prepare_time);
+  line += R"(,"PrepareTime":)";
+  append_ms(line, prepare_time);
+  line += R"(,"Reconnects":)" + std::to_string(m_reconnects);
+  line += R"(,"SlowQueries":)" + std::to_string(m_slow_queries);
+  line += '}';
+
+  return lines;
+}
+
+void query_metrics::merge(const query_metrics &other) {
+  for (const auto &[statement, metrics] : other.m_statements) {
+    auto &merged = get(statement);
+    merged.executions += metrics.executions;
+    merged.rows += metrics.rows;
+    merged.prepare.merge(metrics.prepare);
+    merged.execute.merge(metrics.execute);
+  }
+  m_reconnects += other.m_reconnects;
+  m_slow_queries += other.m_slow_queries;
+}
+
+void query_metrics::reset() {
+  m_statements.clear();
+  m_reconnects = 0;
+  m_slow_queries = 0;
+}
+
+statement_metrics &query_metrics::get(std::string_view statement) {
+  auto found = m_statements.find(statement);
+  if (found == m_statements.end()) {
+    found = m_statements.emplace(std::string(statement), statement_metrics{}).first;
+  }
+  return found->second;
+}
+
+}
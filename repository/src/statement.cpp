@@ -6,7 +6,8 @@
 
 namespace repository {
 
-statement::statement(std::shared_ptr<sql::PreparedStatement> stmt) : base_query(std::move(stmt)) {}
+statement::statement(std::shared_ptr<sql::PreparedStatement> stmt, query_metrics *metrics, std::string_view query)
+    : base_query(std::move(stmt), metrics, query) {}
 
 statement &statement::with_param(int t) {
   this->set_param(t);
@@ -28,13 +29,18 @@ statement &statement::with_param(const std::string &t) {
   return *this;
 }
 
-statement &statement::with_param(long double t) {
+statement &statement::with_param(const models::money &t) {
+  this->set_param(t);
+  return *this;
+}
+
+statement &statement::with_param(const models::guid &t) {
   this->set_param(t);
   return *this;
 }
 
 void statement::go() {
-  get_stmt()->execute();
+  execute();
 }
 
 }
@@ -0,0 +1,56 @@
+//
+// Created by Daniil Ryzhkov on 17/10/2026.
+//
+
+#include <repository/statement_cache.hpp>
+
+namespace repository {
+
+statement_cache::statement_cache(size_t capacity) : m_capacity(capacity) {}
+
+std::shared_ptr<sql::PreparedStatement> statement_cache::prepare(sql::Connection &connection,
+                                                                 std::string_view query) {
+  auto found = m_index.find(query);
+  if (found != m_index.end()) {
+    auto &cached = found->second->second;
+    // a live selector or executor still holds the statement, sharing it would overwrite its parameters and cursor
+    if (cached.use_count() > 1) {
+      m_stats.busy++;
+      return prepare_uncached(connection, query);
+    }
+    m_stats.hits++;
+    m_entries.splice(m_entries.begin(), m_entries, found->second);
+    cached->clearParameters();
+    return cached;
+  }
+
+  m_stats.misses++;
+  auto stmt = prepare_uncached(connection, query);
+  if (m_capacity == 0) {
+    return stmt;
+  }
+
+  if (m_entries.size() >= m_capacity) {
+    m_index.erase(m_entries.back().first);
+    m_entries.pop_back();
+  }
+  m_entries.emplace_front(query, stmt);
+  m_index.emplace(m_entries.front().first, m_entries.begin());
+  return stmt;
+}
+
+std::shared_ptr<sql::PreparedStatement> statement_cache::prepare_uncached(sql::Connection &connection,
+                                                                          std::string_view query) {
+  std::shared_ptr<sql::PreparedStatement> stmt(connection.prepareStatement(std::string(query)));
+  if (!stmt) {
+    throw std::runtime_error("Unable to create prepared statement!");
+  }
+  return stmt;
+}
+
+void statement_cache::clear() {
+  m_index.clear();
+  m_entries.clear();
+}
+
+}
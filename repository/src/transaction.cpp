@@ -0,0 +1,96 @@
+//
+// Created by Daniil Ryzhkov on 17/10/2026.
+//
+
+#include <repository/transaction.hpp>
+
+#include <algorithm>
+#include <string>
+
+#include <lambda/log.hpp>
+
+namespace repository {
+
+transaction::transaction(std::shared_ptr<sql::Connection> connection, transaction_context &context)
+    : m_connection(std::move(connection)), m_context(&context) {
+  if (m_context->depth == 0) {
+    m_connection->setAutoCommit(false);
+  } else {
+    auto name = "sp_" + std::to_string(m_context->depth);
+    m_savepoint.reset(m_connection->setSavepoint(name));
+  }
+  m_context->depth++;
+  m_started = std::chrono::steady_clock::now();
+}
+
+transaction::~transaction() {
+  if (!m_active) {
+    return;
+  }
+  try {
+    rollback();
+  } catch (std::exception &e) {
+    lambda::log.error("Error occurred while rolling back transaction: %s", e.what());
+  }
+}
+
+transaction::transaction(transaction &&other) noexcept
+    : m_connection(std::move(other.m_connection)),
+      m_context(other.m_context),
+      m_savepoint(std::move(other.m_savepoint)),
+      m_started(other.m_started),
+      m_active(other.m_active) {
+  other.m_active = false;
+}
+
+void transaction::commit() {
+  if (!m_active) {
+    throw std::runtime_error("Transaction is already finished!");
+  }
+  if (m_savepoint) {
+    m_connection->releaseSavepoint(m_savepoint.get());
+  } else {
+    m_connection->commit();
+  }
+  finish(true);
+}
+
+void transaction::rollback() {
+  if (!m_active) {
+    throw std::runtime_error("Transaction is already finished!");
+  }
+  // finished even if rollback fails, the server discards the transaction with the connection
+  try {
+    if (m_savepoint) {
+      m_connection->rollback(m_savepoint.get());
+    } else {
+      m_connection->rollback();
+    }
+  } catch (...) {
+    finish(false);
+    throw;
+  }
+  finish(false);
+}
+
+void transaction::finish(bool committed) {
+  m_active = false;
+  m_context->depth--;
+  if (m_savepoint) {
+    return;
+  }
+
+  auto duration = std::chrono::duration_cast<std::chrono::microseconds>(
+      std::chrono::steady_clock::now() - m_started);
+  auto &stats = m_context->stats;
+  (committed ? stats.committed : stats.rolled_back)++;
+  stats.total_duration += duration;
+  stats.max_duration = std::max(stats.max_duration, duration);
+  lambda::log.info("Transaction %s in %.1f ms",
+                   committed ? "committed" : "rolled back",
+                   duration.count() / 1000.0);
+
+  m_connection->setAutoCommit(true);
+}
+
+}
@@ -4,6 +4,7 @@
 
 #pragma once
 
+#include <tuple>
 #include <utility>
 
 #include "api_exception.hpp"
@@ -11,23 +12,23 @@
 #include "utils.hpp"
 #include "responses.hpp"
 #include "parsing.hpp"
+#include "router.hpp"
 
 namespace rest {
 
-class api_resource {
+// Declares routes of a resource into the route tree. Routes are declared once, nested resources are configured
+// when declared and values of their path parameters are passed to handlers ahead of other arguments.
+template<typename ...TParams>
+class basic_api_resource {
  public:
+  basic_api_resource(route_tree &tree, route_tree::node &node) : m_tree(&tree), m_node(&node) {}
+
   auto get(const std::string &path) {
     rest::validate_path(path);
 
-    return [this, path](const auto &&h) {
-      this->m_routes.push_back([path, h](const rest::api_request_t &request, const std::string &p) {
-        if (p != path) {
-          return rest::not_found();
-        }
-        if (request.http_method != "GET") {
-          return rest::method_not_allowed();
-        }
-        return rest::ok(h());
+    return [tree = m_tree, &node = get_node(path)](const auto &&h) {
+      tree->set_endpoint(node, methods::GET, [h](const api_request_t &request, const path_params &params) {
+        return rest::ok(invoke(h, params));
       });
     };
   }
@@ -36,14 +37,8 @@ class api_resource {
   auto post(const std::string &path) {
     rest::validate_path(path);
 
-    return [this, path](const auto &&h) {
-      this->m_routes.push_back([path, h](const rest::api_request_t &request, const std::string &p) {
-        if (p != path) {
-          return rest::not_found();
-        }
-        if (request.http_method != "POST") {
-          return rest::method_not_allowed();
-        }
+    return [tree = m_tree, &node = get_node(path)](const auto &&h) {
+      tree->set_endpoint(node, methods::POST, [h](const api_request_t &request, const path_params &params) {
         TBody body;
         try {
           body = lambda::json::deserialize<TBody>(request.get_body());
@@ -51,8 +46,8 @@ class api_resource {
           return rest::bad_request();
         }
 
-        using THandler = decltype(h);
-        return post_response<THandler, TBody>()(request, std::forward<THandler>(h), body);
+        const auto &&handler = [&h, &params](const TBody &b) { return invoke(h, params, b); };
+        return post_response<decltype(handler), TBody>()(request, std::move(handler), body);
       });
     };
   }
@@ -60,207 +55,133 @@ class api_resource {
   auto post(const std::string &path) {
     rest::validate_path(path);
 
-    return [this, path](const auto &&h) {
-      this->m_routes.push_back([path, h](const rest::api_request_t &request, const std::string &p) {
-        if (p != path) {
-          return rest::not_found();
-        }
-        if (request.http_method != "POST") {
-          return rest::method_not_allowed();
-        }
-
-        using THandler = decltype(h);
-        return post_response<THandler>()(request, std::forward<THandler>(h));
+    return [tree = m_tree, &node = get_node(path)](const auto &&h) {
+      tree->set_endpoint(node, methods::POST, [h](const api_request_t &request, const path_params &params) {
+        const auto &&handler = [&h, &params]() { return invoke(h, params); };
+        return post_response<decltype(handler)>()(request, std::move(handler));
       });
     };
   }
 
   template<typename TBody>
   auto put(const std::string &path) {
-    validate_path(path);
-
-    return [this, path](const auto &&h) {
-      this->m_routes.push_back([path, h](const api_request_t &request, const std::string &p) {
-        if (p != path) {
-          return not_found();
-        }
-        if (request.http_method != "PUT") {
-          return method_not_allowed();
-        }
-        TBody body;
-        try {
-          body = lambda::json::deserialize<TBody>(request.get_body());
-        } catch (std::exception &e) {
-          return bad_request();
-        }
-
-        h(body);
-        return ok();
-      });
-    };
+    return with_body<TBody>(methods::PUT, path);
   }
 
   template<typename TBody>
   auto patch(const std::string &path) {
-    validate_path(path);
-
-    return [this, path](const auto &&h) {
-      this->m_routes.push_back([path, h](const api_request_t &request, const std::string &p) {
-        if (p != path) {
-          return not_found();
-        }
-        if (request.http_method != "PATCH") {
-          return method_not_allowed();
-        }
-        TBody body;
-        try {
-          body = lambda::json::deserialize<TBody>(request.get_body());
-        } catch (std::exception &e) {
-          return bad_request();
-        }
-
-        h(body);
-        return ok();
-      });
-    };
+    return with_body<TBody>(methods::PATCH, path);
   }
 
-  auto any(const std::string &path) {
+  auto del(const std::string &path) {
     validate_path(path);
 
-    return [this, path](auto &&config_function) {
-      this->m_routes.push_back([path, config_function](const api_request_t &request, const std::string &p) {
-        auto next_segment = get_next_segment(p);
-        if (next_segment != path) {
-          return not_found();
-        }
-
-        api_resource nested;
-        config_function(nested);
-
-        auto nested_path = p.size() == path.size() ? "/" : p.substr(path.size());
-        return nested.route(request, nested_path);
+    return [tree = m_tree, &node = get_node(path)](const auto &&h) {
+      tree->set_endpoint(node, methods::DELETE, [h](const api_request_t &request, const path_params &params) {
+        invoke(h, params);
+        return ok();
       });
     };
   }
 
   template<typename TParam>
   auto get() {
-    using TRawParam = typename std::decay<TParam>::type;
-    static_assert(std::is_function<decltype(parser<TRawParam>::parse)>::value, "No parser found for type");
-
-    return [this](const auto &&h) {
-      this->m_routes.push_back([h](const api_request_t &request, const std::string &p) {
-        auto next_segment = get_next_segment(p);
-        if (next_segment.empty()) {
-          return not_found();
-        }
-        if (next_segment.size() != p.size()) {
-          // this is indeed not found, because a non ANY route should not have any segments after the path
-          return not_found();
-        }
-        if (request.http_method != "GET") {
-          return method_not_allowed();
-        }
-        TRawParam param;
-        try {
-          param = parser<TRawParam>::parse(next_segment);
-        } catch (std::exception &e) {
-          return not_found();
-        }
-        return ok(h(param));
-      });
-    };
+    return with_param<TParam>().get("/");
   }
 
   template<typename TParam>
   auto del() {
-    using TRawParam = typename std::decay<TParam>::type;
-    static_assert(std::is_function<decltype(parser<TRawParam>::parse)>::value, "No parser found for type");
-
-    return [this](const auto &&h) {
-      this->m_routes.push_back([h](const api_request_t &request, const std::string &p) {
-        auto next_segment = get_next_segment(p);
-        if (next_segment.empty()) {
-          return not_found();
-        }
-        if (next_segment.size() != p.size()) {
-          // this is indeed not found, because a non ANY route should not have any segments after the path
-          return not_found();
-        }
-        if (request.http_method != "DELETE") {
-          return method_not_allowed();
-        }
-        TRawParam param;
-        try {
-          param = parser<TRawParam>::parse(next_segment);
-        } catch (std::exception &e) {
-          return not_found();
-        }
-        h(param);
-        return ok();
-      });
-    };
+    return with_param<TParam>().del("/");
   }
 
-  auto del(const std::string &path) {
+  auto any(const std::string &path) {
     validate_path(path);
 
-    return [this, path](const auto &&h) {
-      this->m_routes.push_back([h, path](const api_request_t &request, const std::string &p) {
-        auto next_segment = get_next_segment(p);
+    return [nested = basic_api_resource(*m_tree, get_node(path))](auto &&config_function) mutable {
+      config_function(nested);
+    };
+  }
 
-        if (next_segment != path) {
-          return not_found();
-        }
+  template<typename TParam>
+  auto any() {
+    return [nested = with_param<TParam>()](auto &&config_function) mutable {
+      config_function(nested);
+    };
+  }
 
-        if (next_segment.size() != p.size()) {
-          // this is indeed not found, because a non ANY route should not have any segments after the path
-          return not_found();
-        }
+ protected:
+  // Root resource points to the root of the tree once the tree is constructed.
+  explicit basic_api_resource(route_tree &tree) : m_tree(&tree), m_node(nullptr) {}
 
-        if (request.http_method != "DELETE") {
-          return method_not_allowed();
-        }
+  route_tree *m_tree;
+  route_tree::node *m_node;
 
-        h();
-        return ok();
-      });
-    };
+ private:
+  static_assert(sizeof...(TParams) <= path_params::MAX_SIZE, "Too many path parameters");
+
+  route_tree::node &get_node(const std::string &path) {
+    return path.size() == 1 ? *m_node : m_tree->get_static_child(*m_node, std::string_view(path).substr(1));
   }
 
   template<typename TParam>
-  auto any() {
+  auto with_param() {
     using TRawParam = typename std::decay<TParam>::type;
     static_assert(std::is_function<decltype(parser<TRawParam>::parse)>::value, "No parser found for type");
 
-    return [this](auto &&config_function) {
-      this->m_routes.push_back([config_function](const api_request_t &request, const std::string &p) {
-        auto next_segment = get_next_segment(p);
-        if (next_segment.empty()) {
-          return not_found();
-        }
+    return basic_api_resource<TParams..., TRawParam>(*m_tree, m_tree->get_param_child(*m_node, &matches<TRawParam>));
+  }
+
+  template<typename TBody>
+  auto with_body(uint8_t method, const std::string &path) {
+    validate_path(path);
 
-        TRawParam param;
+    return [tree = m_tree, &node = get_node(path), method](const auto &&h) {
+      tree->set_endpoint(node, method, [h](const api_request_t &request, const path_params &params) {
+        TBody body;
         try {
-          param = parser<TRawParam>::parse(next_segment);
+          body = lambda::json::deserialize<TBody>(request.get_body());
         } catch (std::exception &e) {
-          return not_found();
+          return bad_request();
         }
 
-        api_resource nested;
-        config_function(param, nested);
-
-        auto nested_path = next_segment.size() >= p.size() ? "/" : p.substr(next_segment.size());
-        return nested.route(request, nested_path);
+        invoke(h, params, body);
+        return ok();
       });
     };
   }
 
-  api_response_t route(const api_request_t &request, const std::string &p);
+  template<typename TParam>
+  static bool matches(std::string_view segment) {
+    if constexpr (requires { parser<TParam>::matches(segment); }) {
+      return parser<TParam>::matches(segment);
+    } else if constexpr (requires (TParam &value) { parser<TParam>::try_parse(segment, value); }) {
+      TParam value;
+      return parser<TParam>::try_parse(segment, value);
+    } else {
+      TParam value;
+      try {
+        value = parser<TParam>::parse(segment);
+        return true;
+      } catch (std::exception &e) {
+        return false;
+      }
+    }
+  }
+
+  template<typename THandler, typename ...TArgs>
+  static decltype(auto) invoke(const THandler &h, const path_params &params, TArgs &&...args) {
+    return invoke_parsed(h, params, std::index_sequence_for<TParams...>(), std::forward<TArgs>(args)...);
+  }
 
- private:
-  std::vector<std::function<api_response_t(const api_request_t &, const std::string &)>> m_routes;
+  template<typename THandler, size_t ...I, typename ...TArgs>
+  static decltype(auto) invoke_parsed(const THandler &h,
+                                      const path_params &params,
+                                      std::index_sequence<I...>,
+                                      TArgs &&...args) {
+    return h(parser<TParams>::parse(params.values[I])..., std::forward<TArgs>(args)...);
+  }
 };
 
-}
\ No newline at end of file
+using api_resource = basic_api_resource<>;
+
+}
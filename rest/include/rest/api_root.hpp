@@ -4,6 +4,7 @@
 
 #pragma once
 
+#include <memory>
 #include <utility>
 
 #include <aws/lambda-runtime/runtime.h>
@@ -13,25 +14,43 @@
 #include <lambda/logger.hpp>
 
 #include "api_resource.hpp"
+#include "middleware.hpp"
 
 namespace rest {
 
 class api_root : public api_resource {
  public:
   api_root();
-
-  template<typename TMiddleware>
-  void use(const TMiddleware &&middleware) {
-    m_api_entrypoint = [next = m_api_entrypoint, middleware](const api_request_t &request) {
-      return middleware(request, next);
-    };
+  api_root(const api_root &) = delete;
+  api_root &operator=(const api_root &) = delete;
+
+  // Adds middlewares around the ones added before, the last one being the outermost. Middlewares added with
+  // one call form a statically typed pipeline, which is type erased once as a whole.
+  template<typename ...TMiddlewares>
+  void use(TMiddlewares &&...middlewares) {
+    middleware_pipeline<std::decay_t<TMiddlewares>...> pipeline(std::forward<TMiddlewares>(middlewares)...);
+    if (!m_api_entrypoint) {
+      m_api_entrypoint = [this, pipeline = std::move(pipeline)](const api_request_t &request) {
+        return pipeline(request, [this](const api_request_t &r) { return route(r, r.path); });
+      };
+    } else {
+      m_api_entrypoint = [next = std::move(m_api_entrypoint), pipeline = std::move(pipeline)](const api_request_t &request) {
+        return pipeline(request, next);
+      };
+    }
   }
   void use_logging();
 
   api_response_t operator()(const api_request_t &request);
   aws::lambda_runtime::invocation_response operator()(const aws::lambda_runtime::invocation_request &request);
 
+  // Routes the request with the router compiled from declared routes, compiled again after new declarations.
+  api_response_t route(const api_request_t &request, std::string_view path);
+
  private:
+  route_tree m_tree;
+  std::unique_ptr<router> m_router;
+  size_t m_router_version = 0;
   std::function<api_response_t(const api_request_t &)> m_api_entrypoint;
 };
 
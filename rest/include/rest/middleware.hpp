@@ -0,0 +1,64 @@
+//
+// Created by Daniil Ryzhkov on 17/10/2026.
+//
+
+#pragma once
+
+#include <tuple>
+#include <utility>
+
+#include "types.hpp"
+
+namespace rest {
+
+// Middlewares called through statically typed next handlers, so that the compiler can inline the whole chain.
+// The last middleware is the outermost one, as if each of them was added by its own api_root::use call.
+template<typename ...TMiddlewares>
+class middleware_pipeline {
+ public:
+  explicit middleware_pipeline(TMiddlewares ...middlewares) : m_middlewares(std::move(middlewares)...) {}
+
+  template<typename TEndpoint>
+  api_response_t operator()(const api_request_t &request, const TEndpoint &endpoint) const {
+    return call<sizeof...(TMiddlewares)>(request, endpoint);
+  }
+
+ private:
+  std::tuple<TMiddlewares...> m_middlewares;
+
+  // Calls the middleware preceding index I, the endpoint after the first middleware.
+  template<size_t I, typename TEndpoint>
+  struct next {
+    const middleware_pipeline &pipeline;
+    const TEndpoint &endpoint;
+
+    api_response_t operator()(const api_request_t &request) const {
+      return pipeline.template call<I>(request, endpoint);
+    }
+  };
+
+  template<size_t I, typename TEndpoint>
+  api_response_t call(const api_request_t &request, const TEndpoint &endpoint) const {
+    if constexpr (I == 0) {
+      return endpoint(request);
+    } else {
+      return std::get<I - 1>(m_middlewares)(request, next<I - 1, TEndpoint>{*this, endpoint});
+    }
+  }
+};
+
+// Logs method and path of requests and status codes of responses.
+struct logging_middleware {
+  template<typename TNext>
+  api_response_t operator()(const api_request_t &request, const TNext &next) const {
+    log_request(request);
+    auto response = next(request);
+    log_response(request, response);
+    return response;
+  }
+
+  static void log_request(const api_request_t &request);
+  static void log_response(const api_request_t &request, const api_response_t &response);
+};
+
+}
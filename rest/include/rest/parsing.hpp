@@ -5,14 +5,18 @@
 #pragma once
 
 #include <stdexcept>
+#include <string_view>
 
 #include "utils.hpp"
 
 namespace rest {
 
-int parse_int(const std::string &s);
-std::string parse_string(const std::string &s);
+bool try_parse_int(std::string_view s, int &output);
+int parse_int(std::string_view s);
+std::string parse_string(std::string_view s);
 
+// Parses path parameters. Routing matches path segments with matches, a check that builds no value, when the
+// parser defines it, or with try_parse, which must not throw, and falls back to parse otherwise.
 template<typename TParam>
 struct parser {
   constexpr static auto parse = 0;
@@ -20,16 +24,25 @@ struct parser {
 
 template<>
 struct parser<int> {
-  static int parse(const std::string &s) {
+  static int parse(std::string_view s) {
     return parse_int(s);
   }
+
+  static bool try_parse(std::string_view s, int &output) {
+    return try_parse_int(s, output);
+  }
 };
 
 template<>
 struct parser<std::string> {
-  static std::string parse(const std::string &s) {
+  static std::string parse(std::string_view s) {
     return parse_string(s);
   }
+
+  // Any segment is a string, nothing is copied to tell so.
+  static bool matches(std::string_view s) {
+    return !s.empty();
+  }
 };
 
-}
\ No newline at end of file
+}
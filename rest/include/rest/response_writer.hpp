@@ -0,0 +1,22 @@
+//
+// Created by Daniil Ryzhkov on 17/10/2026.
+//
+
+#pragma once
+
+#include <string>
+#include <string_view>
+
+#include "types.hpp"
+
+namespace rest {
+
+// Appends the text as contents of a JSON string, escaping quotes, backslashes and control characters.
+// Text is scanned eight bytes at a time and runs without such characters are copied at once.
+void append_escaped(std::string &output, std::string_view text);
+
+// Writes the gateway proxy response as compact JSON into one buffer, the already serialized body is escaped
+// straight into it instead of being serialized once more.
+std::string write_response(const api_response_t &response);
+
+}
@@ -0,0 +1,106 @@
+//
+// Created by Daniil Ryzhkov on 17/10/2026.
+//
+
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "types.hpp"
+#include "utils.hpp"
+
+namespace rest {
+
+// Bits of HTTP methods in the method mask of a route node.
+namespace methods {
+
+constexpr uint8_t GET = 1 << 0;
+constexpr uint8_t POST = 1 << 1;
+constexpr uint8_t PUT = 1 << 2;
+constexpr uint8_t PATCH = 1 << 3;
+constexpr uint8_t DELETE = 1 << 4;
+constexpr size_t COUNT = 5;
+
+// Returns zero for methods routes cannot be declared for.
+uint8_t parse(std::string_view method);
+
+}
+
+// Values of parameter segments matched on the way to an endpoint, outermost first.
+struct path_params {
+  static constexpr size_t MAX_SIZE = 8;
+
+  std::array<std::string_view, MAX_SIZE> values;
+  size_t size = 0;
+};
+
+typedef std::function<api_response_t(const api_request_t &, const path_params &)> endpoint_t;
+
+// Tells whether a path segment is a valid value of a parameter, the same function stands for the same parameter type.
+typedef bool (*segment_matcher_t)(std::string_view segment);
+
+// Routes in the order they are declared, compiled into a router before serving requests.
+class route_tree {
+ public:
+  struct node {
+    std::vector<std::pair<std::string, std::unique_ptr<node>>> static_children;
+    std::vector<std::pair<segment_matcher_t, std::unique_ptr<node>>> param_children;
+    std::array<endpoint_t, methods::COUNT> endpoints;
+    uint8_t method_mask = 0;
+  };
+
+  node &get_root() { return m_root; }
+  [[nodiscard]] const node &get_root() const { return m_root; }
+
+  node &get_static_child(node &parent, std::string_view segment);
+  node &get_param_child(node &parent, segment_matcher_t matcher);
+
+  // The first endpoint declared for a method of a node is kept, as the first matching route was served before.
+  void set_endpoint(node &target, uint8_t method, endpoint_t endpoint);
+
+  // Changes with every declaration, so that a compiled router can tell it is out of date.
+  [[nodiscard]] size_t get_version() const { return m_version; }
+
+ private:
+  node m_root;
+  size_t m_version = 0;
+};
+
+// Immutable radix trie of routes. Chains of static segments without branches or endpoints are merged
+// into one node, static children are searched by segment and parameter children are tried in declaration
+// order. Empty segments and trailing slashes of the path are ignored.
+class router {
+ public:
+  explicit router(const route_tree &tree);
+
+  // Responds 404 when no route matches the path and 405 when routes match the path but not the method.
+  api_response_t route(const api_request_t &request, std::string_view path) const;
+
+ private:
+  struct node {
+    // static segments of the merged chain leading to the node, beyond the first one it is found by
+    std::vector<std::string> tail;
+    std::vector<std::pair<std::string, uint32_t>> static_children;
+    std::vector<std::pair<segment_matcher_t, uint32_t>> param_children;
+    std::array<const endpoint_t *, methods::COUNT> endpoints{};
+    uint8_t method_mask = 0;
+  };
+
+  std::vector<node> m_nodes;
+
+  uint32_t compile(const route_tree::node &source, std::vector<std::string> tail);
+
+  const node *find(const node &current,
+                   path_segments path,
+                   uint8_t method,
+                   path_params &params,
+                   bool &method_mismatch) const;
+};
+
+}
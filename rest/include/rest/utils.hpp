@@ -5,6 +5,7 @@
 #pragma once
 
 #include <string>
+#include <string_view>
 
 namespace rest {
 
@@ -18,8 +19,21 @@ inline std::string id_to_string(const std::string &id) {
   return id;
 }
 
-std::string remove_slashes(const std::string &s);
-std::string get_next_segment(const std::string &path);
-void validate_path(const std::string &path);
+// Iterates non-empty segments of a path without copying, e.g. "v1" and "receipts" of "/v1//receipts/".
+// Copies are independent, so a copy can be taken to come back to the current segment.
+class path_segments {
+ public:
+  explicit path_segments(std::string_view path) : m_path(path) {}
 
-}
\ No newline at end of file
+  // Returns the next segment, or an empty one at the end of the path.
+  std::string_view next();
+
+ private:
+  std::string_view m_path;
+};
+
+std::string remove_slashes(std::string_view s);
+std::string_view get_next_segment(std::string_view path);
+void validate_path(std::string_view path);
+
+}
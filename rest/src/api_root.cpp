@@ -3,27 +3,29 @@
 //
 
 #include <rest/api_root.hpp>
+#include <rest/response_writer.hpp>
 #include <lambda/log.hpp>
 
 namespace rest {
 
-api_root::api_root() {
-  m_api_entrypoint = [&](const api_request_t &request) {
-    return route(request, request.path);
-  };
+api_root::api_root() : api_resource(m_tree) {
+  m_node = &m_tree.get_root();
 }
 
 void api_root::use_logging() {
-  use([](const api_request_t &request, const auto &next) {
-    lambda::log.info("Request: %s %s", request.http_method.c_str(), request.path.c_str());
-    auto response = next(request);
-    lambda::log.info("%s %s Response: %d", request.http_method.c_str(), request.path.c_str(), response.status_code);
-    return response;
-  });
+  use(logging_middleware());
+}
+
+api_response_t api_root::route(const api_request_t &request, std::string_view path) {
+  if (!m_router || m_router_version != m_tree.get_version()) {
+    m_router = std::make_unique<router>(m_tree);
+    m_router_version = m_tree.get_version();
+  }
+  return m_router->route(request, path);
 }
 
 api_response_t api_root::operator()(const api_request_t &request) {
-  return m_api_entrypoint(request);
+  return m_api_entrypoint ? m_api_entrypoint(request) : route(request, request.path);
 }
 
 aws::lambda_runtime::invocation_response api_root::operator()(const aws::lambda_runtime::invocation_request &request) {
@@ -31,8 +33,7 @@ aws::lambda_runtime::invocation_response api_root::operator()(const aws::lambda_
 
   api_response_t response = this->operator()(gpr);
 
-  auto response_json = lambda::json::serialize(response, true);
-  return aws::lambda_runtime::invocation_response::success(response_json, "application/json");
+  return aws::lambda_runtime::invocation_response::success(write_response(response), "application/json");
 }
 
 }
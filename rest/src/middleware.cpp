@@ -0,0 +1,18 @@
+//
+// Created by Daniil Ryzhkov on 17/10/2026.
+//
+
+#include <rest/middleware.hpp>
+#include <lambda/log.hpp>
+
+namespace rest {
+
+void logging_middleware::log_request(const api_request_t &request) {
+  lambda::log.info("Request: %s %s", request.http_method.c_str(), request.path.c_str());
+}
+
+void logging_middleware::log_response(const api_request_t &request, const api_response_t &response) {
+  lambda::log.info("%s %s Response: %d", request.http_method.c_str(), request.path.c_str(), response.status_code);
+}
+
+}
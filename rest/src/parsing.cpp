@@ -2,22 +2,33 @@
 // Created by Daniil Ryzhkov on 02/06/2024.
 //
 
+#include <charconv>
+
 #include <rest/parsing.hpp>
 
 namespace rest {
 
-int parse_int(const std::string &s) {
-  std::string int_text = rest::remove_slashes(s);
-  size_t pos;
-  auto res = std::stoi(int_text, &pos);
-  if (pos != int_text.size()) {
+bool try_parse_int(std::string_view s, int &output) {
+  auto first = s.find_first_not_of('/');
+  auto last = s.find_last_not_of('/');
+  if (first == std::string_view::npos) {
+    return false;
+  }
+  auto text = s.substr(first, last - first + 1);
+  auto [end, error] = std::from_chars(text.data(), text.data() + text.size(), output);
+  return error == std::errc() && end == text.data() + text.size();
+}
+
+int parse_int(std::string_view s) {
+  int output;
+  if (!try_parse_int(s, output)) {
     throw std::invalid_argument("Cannot parse int");
   }
-  return res;
+  return output;
 }
 
-std::string parse_string(const std::string &s) {
+std::string parse_string(std::string_view s) {
   return rest::remove_slashes(s);
 }
 
-}
\ No newline at end of file
+}
@@ -0,0 +1,135 @@
+//
+// Created by Daniil Ryzhkov on 17/10/2026.
+//
+
+#include <algorithm>
+#include <charconv>
+#include <cstdint>
+#include <cstring>
+
+#include <rest/response_writer.hpp>
+
+namespace rest {
+
+namespace {
+
+constexpr uint64_t ONES = 0x0101010101010101ULL;
+constexpr uint64_t HIGH_BITS = 0x8080808080808080ULL;
+
+// Tells whether any byte of the word is less than n, n must not exceed 128.
+constexpr bool has_less(uint64_t word, uint8_t n) {
+  return ((word - ONES * n) & ~word & HIGH_BITS) != 0;
+}
+
+constexpr bool has_byte(uint64_t word, uint8_t byte) {
+  return has_less(word ^ (ONES * byte), 1);
+}
+
+constexpr bool needs_escape(uint64_t word) {
+  return has_less(word, 0x20) || has_byte(word, '"') || has_byte(word, '\\');
+}
+
+constexpr bool needs_escape(unsigned char c) {
+  return c < 0x20 || c == '"' || c == '\\';
+}
+
+void append_escape(std::string &output, unsigned char c) {
+  switch (c) {
+    case '"': output += "\\\""; return;
+    case '\\': output += "\\\\"; return;
+    case '\b': output += "\\b"; return;
+    case '\f': output += "\\f"; return;
+    case '\n': output += "\\n"; return;
+    case '\r': output += "\\r"; return;
+    case '\t': output += "\\t"; return;
+    default: {
+      constexpr char HEX[] = "0123456789abcdef";
+      const char escape[] = {'\\', 'u', '0', '0', HEX[c >> 4], HEX[c & 0xf]};
+      output.append(escape, sizeof(escape));
+    }
+  }
+}
+
+void append_string(std::string &output, std::string_view text) {
+  output += '"';
+  append_escaped(output, text);
+  output += '"';
+}
+
+}
+
+void append_escaped(std::string &output, std::string_view text) {
+  const char *data = text.data();
+  size_t size = text.size();
+  size_t copied = 0;
+  size_t i = 0;
+  while (i < size) {
+    if (i + sizeof(uint64_t) <= size) {
+      uint64_t word;
+      std::memcpy(&word, data + i, sizeof(word));
+      if (!needs_escape(word)) {
+        i += sizeof(word);
+        continue;
+      }
+    }
+
+    auto end = std::min(i + sizeof(uint64_t), size);
+    for (; i < end; i++) {
+      auto c = static_cast<unsigned char>(data[i]);
+      if (needs_escape(c)) {
+        output.append(data + copied, i - copied);
+        append_escape(output, c);
+        copied = i + 1;
+      }
+    }
+  }
+  output.append(data + copied, size - copied);
+}
+
+std::string write_response(const api_response_t &response) {
+  // room for the envelope and a few escaped characters, the buffer only grows for bodies with many of them
+  size_t capacity = 96 + response.body.size() + response.body.size() / 16;
+  for (const auto &[name, value] : response.headers) {
+    capacity += name.size() + value.size() + 6;
+  }
+
+  std::string output;
+  output.reserve(capacity);
+
+  output += R"({"statusCode":)";
+  char status[16];
+  output.append(status, std::to_chars(status, status + sizeof(status), response.status_code).ptr);
+
+  output += R"(,"headers":{)";
+  bool first = true;
+  for (const auto &[name, value] : response.headers) {
+    if (!first) output += ',';
+    first = false;
+    append_string(output, name);
+    output += ':';
+    append_string(output, value);
+  }
+
+  output += R"(},"multiValueHeaders":{)";
+  first = true;
+  for (const auto &[name, values] : response.multi_value_headers) {
+    if (!first) output += ',';
+    first = false;
+    append_string(output, name);
+    output += ":[";
+    for (size_t i = 0; i < values.size(); i++) {
+      if (i > 0) output += ',';
+      append_string(output, values[i]);
+    }
+    output += ']';
+  }
+
+  output += R"(},"body":)";
+  append_string(output, response.body);
+  output += R"(,"isBase64Encoded":)";
+  output += response.is_base64_encoded ? "true" : "false";
+  output += '}';
+  return output;
+}
+
+}
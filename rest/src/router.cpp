@@ -0,0 +1,150 @@
+//
+// Created by Daniil Ryzhkov on 17/10/2026.
+//
+
+#include <algorithm>
+#include <bit>
+
+#include <rest/router.hpp>
+#include <rest/responses.hpp>
+
+namespace rest {
+
+namespace {
+
+size_t method_index(uint8_t method) {
+  return std::countr_zero(method);
+}
+
+}
+
+uint8_t methods::parse(std::string_view method) {
+  if (method == "GET") return GET;
+  if (method == "POST") return POST;
+  if (method == "PUT") return PUT;
+  if (method == "PATCH") return PATCH;
+  if (method == "DELETE") return DELETE;
+  return 0;
+}
+
+route_tree::node &route_tree::get_static_child(node &parent, std::string_view segment) {
+  m_version++;
+  for (auto &[child_segment, child] : parent.static_children) {
+    if (child_segment == segment) {
+      return *child;
+    }
+  }
+  return *parent.static_children.emplace_back(std::string(segment), std::make_unique<node>()).second;
+}
+
+route_tree::node &route_tree::get_param_child(node &parent, segment_matcher_t matcher) {
+  m_version++;
+  for (auto &[child_matcher, child] : parent.param_children) {
+    if (child_matcher == matcher) {
+      return *child;
+    }
+  }
+  return *parent.param_children.emplace_back(matcher, std::make_unique<node>()).second;
+}
+
+void route_tree::set_endpoint(node &target, uint8_t method, endpoint_t endpoint) {
+  if (target.method_mask & method) {
+    return;
+  }
+  m_version++;
+  target.endpoints[method_index(method)] = std::move(endpoint);
+  target.method_mask |= method;
+}
+
+router::router(const route_tree &tree) {
+  compile(tree.get_root(), {});
+}
+
+uint32_t router::compile(const route_tree::node &source, std::vector<std::string> tail) {
+  const auto *current = &source;
+  while (current->method_mask == 0 && current->param_children.empty() && current->static_children.size() == 1) {
+    tail.push_back(current->static_children[0].first);
+    current = current->static_children[0].second.get();
+  }
+
+  auto index = static_cast<uint32_t>(m_nodes.size());
+  m_nodes.emplace_back();
+  m_nodes[index].tail = std::move(tail);
+  m_nodes[index].method_mask = current->method_mask;
+  for (size_t i = 0; i < methods::COUNT; i++) {
+    if (current->method_mask & (1 << i)) {
+      m_nodes[index].endpoints[i] = &current->endpoints[i];
+    }
+  }
+
+  // children are compiled first, nodes vector may grow meanwhile
+  std::vector<std::pair<std::string, uint32_t>> static_children;
+  for (const auto &[segment, child] : current->static_children) {
+    static_children.emplace_back(segment, compile(*child, {}));
+  }
+  std::sort(static_children.begin(), static_children.end());
+  std::vector<std::pair<segment_matcher_t, uint32_t>> param_children;
+  for (const auto &[matcher, child] : current->param_children) {
+    param_children.emplace_back(matcher, compile(*child, {}));
+  }
+
+  m_nodes[index].static_children = std::move(static_children);
+  m_nodes[index].param_children = std::move(param_children);
+  return index;
+}
+
+const router::node *router::find(const node &current,
+                                 path_segments path,
+                                 uint8_t method,
+                                 path_params &params,
+                                 bool &method_mismatch) const {
+  for (const auto &segment : current.tail) {
+    if (path.next() != segment) {
+      return nullptr;
+    }
+  }
+
+  auto segment = path.next();
+  if (segment.empty()) {
+    if (current.method_mask & method) {
+      return &current;
+    }
+    method_mismatch |= current.method_mask != 0;
+    return nullptr;
+  }
+
+  auto child = std::lower_bound(current.static_children.begin(), current.static_children.end(), segment,
+                                [](const auto &entry, std::string_view value) { return entry.first < value; });
+  if (child != current.static_children.end() && child->first == segment) {
+    if (const auto *found = find(m_nodes[child->second], path, method, params, method_mismatch)) {
+      return found;
+    }
+  }
+
+  // a parameter that does not parse does not match, as the route was not found before
+  for (const auto &[matcher, index] : current.param_children) {
+    if (params.size == path_params::MAX_SIZE || !matcher(segment)) {
+      continue;
+    }
+    params.values[params.size++] = segment;
+    if (const auto *found = find(m_nodes[index], path, method, params, method_mismatch)) {
+      return found;
+    }
+    params.size--;
+  }
+
+  return nullptr;
+}
+
+api_response_t router::route(const api_request_t &request, std::string_view path) const {
+  auto method = methods::parse(request.http_method);
+  path_params params;
+  bool method_mismatch = false;
+  const auto *found = find(m_nodes[0], path_segments(path), method, params, method_mismatch);
+  if (found) {
+    return (*found->endpoints[method_index(method)])(request, params);
+  }
+  return method_mismatch ? method_not_allowed() : not_found();
+}
+
+}
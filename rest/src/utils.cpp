@@ -2,40 +2,52 @@
 // Created by Daniil Ryzhkov on 02/06/2024.
 //
 
+#include <algorithm>
 #include <stdexcept>
 
 #include <rest/utils.hpp>
 
 namespace rest {
 
-std::string remove_slashes(const std::string &s) {
-  std::string text = s;
-  std::string::size_type pos = 0;
-  while ((pos = text.find('/', pos)) != std::string::npos) {
-    text.erase(pos, 1);
+std::string_view path_segments::next() {
+  auto start = m_path.find_first_not_of('/');
+  if (start == std::string_view::npos) {
+    m_path = {};
+    return {};
   }
+  auto end = m_path.find('/', start);
+  if (end == std::string_view::npos) {
+    auto segment = m_path.substr(start);
+    m_path = {};
+    return segment;
+  }
+  auto segment = m_path.substr(start, end - start);
+  m_path.remove_prefix(end);
+  return segment;
+}
+
+std::string remove_slashes(std::string_view s) {
+  std::string text;
+  text.reserve(s.size());
+  std::remove_copy(s.begin(), s.end(), std::back_inserter(text), '/');
   return text;
 }
 
-std::string get_next_segment(const std::string &path) {
+std::string_view get_next_segment(std::string_view path) {
   auto next_pos = path.find('/', 1);
-  if (next_pos == std::string::npos) {
-    return path;
-  } else {
-    return path.substr(0, next_pos);
-  }
+  return next_pos == std::string_view::npos ? path : path.substr(0, next_pos);
 }
 
-void validate_path(const std::string &path) {
+void validate_path(std::string_view path) {
   if (path.empty()) {
     throw std::invalid_argument("Path cannot be empty");
   }
   if (path[0] != '/') {
     throw std::invalid_argument("Path must start with /");
   }
-  if (path.size() > 1 && path.find('/', 1) != std::string::npos) {
+  if (path.size() > 1 && path.find('/', 1) != std::string_view::npos) {
     throw std::invalid_argument("Path cannot contain more than one segment");
   }
 }
 
-}
\ No newline at end of file
+}
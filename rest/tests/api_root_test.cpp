@@ -483,8 +483,8 @@ TEST(api_root, any_should_configure_nested_routes) {
 
 TEST(api_root, any_should_pass_parameters_to_nested_routes) {
   api_root api;
-  api.any<int>()([](int id, api_resource &res) {
-    res.get("/")([id]() { return test_response{.value = std::to_string(id)}; });
+  api.any<int>()([](basic_api_resource<int> &res) {
+    res.get("/")([](int id) { return test_response{.value = std::to_string(id)}; });
   });
   api_request_t request;
   request.path = "/123";
@@ -496,8 +496,8 @@ TEST(api_root, any_should_pass_parameters_to_nested_routes) {
 
 TEST(api_root, nested_route_should_be_reachable_behind_parameter) {
   api_root api;
-  api.any<int>()([](int id, api_resource &res) {
-    res.get("/456")([id]() { return test_response{.value = std::to_string(id)}; });
+  api.any<int>()([](basic_api_resource<int> &res) {
+    res.get("/456")([](int id) { return test_response{.value = std::to_string(id)}; });
   });
   api_request_t request;
   request.path = "/123/456";
@@ -509,8 +509,8 @@ TEST(api_root, nested_route_should_be_reachable_behind_parameter) {
 
 TEST(api_root, nested_route_should_capture_outside_parameters) {
   api_root api;
-  api.any<int>()([](int id, api_resource &res) {
-    res.get<int>()([id](int id2) { return test_response{.value = std::to_string(id + id2)}; });
+  api.any<int>()([](basic_api_resource<int> &res) {
+    res.get<int>()([](int id, int id2) { return test_response{.value = std::to_string(id + id2)}; });
   });
   api_request_t request;
   request.path = "/2/2";
@@ -541,11 +541,11 @@ TEST(api_root, any_should_support_multiple_nested_routes) {
 
 TEST(api_root, any_should_support_multiple_nested_routes_with_parameters) {
   api_root api;
-  api.any<int>()([](int id, api_resource &res) {
-    res.any<int>()([](int id2, api_resource &res) {
-      res.any<int>()([](int id3, api_resource &res) {
-        res.any<int>()([](int id4, api_resource &res) {
-          res.get("/")([id4]() { return test_response{.value = std::to_string(id4)}; });
+  api.any<int>()([](auto &res) {
+    res.template any<int>()([](auto &res) {
+      res.template any<int>()([](auto &res) {
+        res.template any<int>()([](auto &res) {
+          res.get("/")([](int id, int id2, int id3, int id4) { return test_response{.value = std::to_string(id4)}; });
         });
       });
     });
@@ -615,3 +615,111 @@ TEST(api_root, middleware_should_be_executed_in_order) {
   std::vector<int> expected_values = {1, 2};
   EXPECT_EQ(values, expected_values);
 }
+
+TEST(api_root, middleware_pipeline_should_be_executed_in_order) {
+  api_root api;
+  std::vector<int> values;
+  api.get("/")([]() { return test_response{.value = "123"}; });
+  api.use([&values](const api_request_t &req, auto next) {
+    values.push_back(4);
+    return next(req);
+  });
+  api.use([&values](const api_request_t &req, auto next) {
+            values.push_back(3);
+            return next(req);
+          },
+          [&values](const api_request_t &req, auto next) {
+            values.push_back(2);
+            return next(req);
+          });
+  api.use([&values](const api_request_t &req, auto next) {
+    values.push_back(1);
+    return next(req);
+  });
+  api_request_t request;
+  request.path = "/";
+  request.http_method = "GET";
+  auto response = api(request);
+  std::vector<int> expected_values = {1, 2, 3, 4};
+  EXPECT_EQ(values, expected_values);
+  EXPECT_EQ(response.body, R"({"value":"123"})");
+}
+
+TEST(api_root, middleware_should_short_circuit_pipeline) {
+  api_root api;
+  bool called = false;
+  api.get("/")([]() { return test_response{.value = "123"}; });
+  api.use([&called](const api_request_t &req, auto next) {
+            called = true;
+            return next(req);
+          },
+          [](const api_request_t &req, auto next) {
+            return unauthorized();
+          });
+  api_request_t request;
+  request.path = "/";
+  request.http_method = "GET";
+  EXPECT_EQ(api(request).status_code, 401);
+  EXPECT_FALSE(called);
+}
+
+// Route tree
+
+TEST(api_root, static_segment_should_take_precedence_over_parameter) {
+  api_root api;
+  api.get<std::string>()([](const std::string &id) { return test_response{.value = id}; });
+  api.get("/changes")([]() { return test_response{.value = "changes"}; });
+  api_request_t request;
+  request.path = "/changes";
+  request.http_method = "GET";
+  EXPECT_EQ(api(request).body, R"({"value":"changes"})");
+  request.path = "/123";
+  EXPECT_EQ(api(request).body, R"({"value":"123"})");
+}
+
+TEST(api_root, parameter_should_fall_back_to_next_matching_type) {
+  api_root api;
+  api.any<int>()([](basic_api_resource<int> &res) {
+    res.get("/items")([](int id) { return test_response{.value = "int " + std::to_string(id)}; });
+  });
+  api.any<std::string>()([](basic_api_resource<std::string> &res) {
+    res.get("/items")([](const std::string &id) { return test_response{.value = "string " + id}; });
+  });
+  api_request_t request;
+  request.path = "/123/items";
+  request.http_method = "GET";
+  EXPECT_EQ(api(request).body, R"({"value":"int 123"})");
+  request.path = "/abc/items";
+  EXPECT_EQ(api(request).body, R"({"value":"string abc"})");
+}
+
+TEST(api_root, method_not_allowed_should_be_returned_when_any_matching_route_allows_other_method) {
+  api_root api;
+  api.any("/1")([](api_resource &res) {
+    res.any("/2")([](api_resource &res) {
+      res.del<int>()([](int id) {});
+    });
+  });
+  api_request_t request;
+  request.path = "/1/2/3";
+  request.http_method = "GET";
+  EXPECT_EQ(api(request).status_code, 405);
+  request.path = "/1/2/a";
+  EXPECT_EQ(api(request).status_code, 404);
+  request.path = "/1/2";
+  EXPECT_EQ(api(request).status_code, 404);
+  request.http_method = "DELETE";
+  request.path = "/1/2/3";
+  EXPECT_EQ(api(request).status_code, 200);
+}
+
+TEST(api_root, routes_declared_after_routing_should_be_served) {
+  api_root api;
+  api.get("/1")([]() { return test_response{.value = "1"}; });
+  api_request_t request;
+  request.path = "/2";
+  request.http_method = "GET";
+  EXPECT_EQ(api(request).status_code, 404);
+  api.get("/2")([]() { return test_response{.value = "2"}; });
+  EXPECT_EQ(api(request).status_code, 200);
+}
@@ -0,0 +1,81 @@
+//
+// Created by Daniil Ryzhkov on 17/10/2026.
+//
+
+#include <gtest/gtest.h>
+#include <integration_tests_common/benchmark.hpp>
+#include <rest/api_root.hpp>
+
+using namespace rest;
+
+#define BENCHMARK_REQUESTS 100000
+
+struct middleware_benchmark_response {
+  int value = 0;
+
+  JSON_BEGIN_SERIALIZER(middleware_benchmark_response)
+      JSON_PROPERTY("value", value)
+  JSON_END_SERIALIZER()
+};
+
+// Passes the request on, counting calls so that the middleware is not optimized away.
+struct counting_middleware {
+  int *calls;
+
+  template<typename TNext>
+  api_response_t operator()(const api_request_t &request, const TNext &next) const {
+    (*calls)++;
+    return next(request);
+  }
+};
+
+// Returns middleware calls and size of the responses as work.
+static benchmark::measurement measure_requests(api_root &api, const int &calls) {
+  api_request_t request;
+  request.http_method = "GET";
+  request.path = "/";
+  return benchmark::measure<std::nano>(BENCHMARK_REQUESTS, [&]() {
+    auto before = calls;
+    auto response = api(request);
+    EXPECT_EQ(response.status_code, 200);
+    return (size_t) (calls - before) + response.body.size();
+  });
+}
+
+TEST(middleware_benchmark, per_request_overhead) {
+  int endpoint_calls = 0;
+  auto declare_endpoint = [&endpoint_calls](api_root &api) {
+    // endpoint calls are not part of the returned value, so that every api returns the same body
+    api.get("/")([&endpoint_calls]() {
+      endpoint_calls++;
+      return middleware_benchmark_response{.value = 1};
+    });
+  };
+
+  int bare_calls = 0;
+  api_root bare;
+  declare_endpoint(bare);
+  auto without_middleware = measure_requests(bare, bare_calls);
+
+  // six middlewares as in the api, each added by its own call
+  int chained_calls = 0;
+  api_root chained;
+  declare_endpoint(chained);
+  for (int i = 0; i < 6; i++) {
+    chained.use(counting_middleware{&chained_calls});
+  }
+  auto chained_requests = measure_requests(chained, chained_calls);
+
+  // the same middlewares added as one statically typed pipeline
+  int pipeline_calls = 0;
+  api_root pipeline;
+  declare_endpoint(pipeline);
+  counting_middleware middleware{&pipeline_calls};
+  pipeline.use(middleware, middleware, middleware, middleware, middleware, middleware);
+  auto pipeline_requests = measure_requests(pipeline, pipeline_calls);
+
+  ASSERT_EQ(chained_calls, BENCHMARK_REQUESTS * 6);
+  ASSERT_EQ(endpoint_calls, BENCHMARK_REQUESTS * 3);
+  benchmark::report("Without middleware", "ns", without_middleware);
+  benchmark::compare("6 chained vs pipelined middlewares", "ns", chained_requests, pipeline_requests);
+}
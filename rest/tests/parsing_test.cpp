@@ -0,0 +1,64 @@
+//
+// Created by Daniil Ryzhkov on 17/10/2026.
+//
+
+#include <vector>
+#include <gtest/gtest.h>
+#include <rest/parsing.hpp>
+
+using namespace rest;
+
+static std::vector<std::string_view> all_segments(std::string_view path) {
+  std::vector<std::string_view> segments;
+  path_segments iterator(path);
+  for (auto segment = iterator.next(); !segment.empty(); segment = iterator.next()) {
+    segments.push_back(segment);
+  }
+  return segments;
+}
+
+TEST(parsing, path_segments_should_skip_empty_segments) {
+  EXPECT_EQ(all_segments("/v1/receipts/123"), (std::vector<std::string_view>{"v1", "receipts", "123"}));
+  EXPECT_EQ(all_segments("//v1//receipts/"), (std::vector<std::string_view>{"v1", "receipts"}));
+  EXPECT_EQ(all_segments("v1"), (std::vector<std::string_view>{"v1"}));
+  EXPECT_TRUE(all_segments("/").empty());
+  EXPECT_TRUE(all_segments("").empty());
+}
+
+TEST(parsing, path_segments_should_point_into_path) {
+  std::string path = "/v1/receipts";
+  path_segments iterator(path);
+  auto copy = iterator;
+  EXPECT_EQ(iterator.next().data(), path.data() + 1);
+  EXPECT_EQ(iterator.next().data(), path.data() + 4);
+  EXPECT_EQ(copy.next(), "v1");
+}
+
+TEST(parsing, int_should_parse_whole_segment) {
+  int value = 0;
+  EXPECT_TRUE(try_parse_int("123", value));
+  EXPECT_EQ(value, 123);
+  EXPECT_TRUE(try_parse_int("/-7/", value));
+  EXPECT_EQ(value, -7);
+  EXPECT_EQ(parse_int("2024"), 2024);
+
+  EXPECT_FALSE(try_parse_int("", value));
+  EXPECT_FALSE(try_parse_int("/", value));
+  EXPECT_FALSE(try_parse_int("12a", value));
+  EXPECT_FALSE(try_parse_int(" 12", value));
+  EXPECT_FALSE(try_parse_int("99999999999", value));
+  EXPECT_THROW(parse_int("abc"), std::invalid_argument);
+}
+
+TEST(parsing, string_should_match_any_segment) {
+  EXPECT_TRUE(parser<std::string>::matches("abc"));
+  EXPECT_TRUE(parser<std::string>::matches("123"));
+  EXPECT_FALSE(parser<std::string>::matches(""));
+}
+
+TEST(parsing, string_should_drop_slashes) {
+  EXPECT_EQ(parse_string("/abc/"), "abc");
+  EXPECT_EQ(remove_slashes("/a/b/c"), "abc");
+  EXPECT_EQ(get_next_segment("/a/b"), "/a");
+  EXPECT_EQ(get_next_segment("/a"), "/a");
+}
@@ -0,0 +1,56 @@
+//
+// Created by Daniil Ryzhkov on 17/10/2026.
+//
+
+#include <gtest/gtest.h>
+#include <rest/response_writer.hpp>
+#include <rest/responses.hpp>
+
+using namespace rest;
+
+static std::string escaped(std::string_view text) {
+  std::string output;
+  append_escaped(output, text);
+  return output;
+}
+
+TEST(response_writer, should_escape_special_characters) {
+  EXPECT_EQ(escaped(R"({"value":"a\b"})"), R"({\"value\":\"a\\b\"})");
+  EXPECT_EQ(escaped("line\nnext\ttab\r\b\f"), R"(line\nnext\ttab\r\b\f)");
+  EXPECT_EQ(escaped(std::string_view("\x01\x1f", 2)), R"(\u0001\u001f)");
+  EXPECT_EQ(escaped(""), "");
+}
+
+TEST(response_writer, should_copy_text_without_special_characters) {
+  EXPECT_EQ(escaped("plain"), "plain");
+  EXPECT_EQ(escaped("Žluťoučký kůň €"), "Žluťoučký kůň €");
+  EXPECT_EQ(escaped("~~~~~~~~\x7f"), "~~~~~~~~\x7f");
+}
+
+TEST(response_writer, should_escape_at_any_position_of_long_text) {
+  std::string text(37, 'a');
+  for (size_t i = 0; i < text.size(); i++) {
+    auto input = text;
+    input[i] = '"';
+    auto expected = text.substr(0, i) + "\\\"" + text.substr(i + 1);
+    EXPECT_EQ(escaped(input), expected) << "quote at " << i;
+  }
+}
+
+TEST(response_writer, should_write_compact_envelope) {
+  auto response = ok();
+  response.set_body(R"({"value":"123"})", false);
+  response.headers["Access-Control-Allow-Origin"] = "https://speza.it";
+  response.headers["Location"] = "/123";
+  EXPECT_EQ(write_response(response),
+            R"({"statusCode":200,)"
+            R"("headers":{"Access-Control-Allow-Origin":"https://speza.it","Location":"/123"},)"
+            R"("multiValueHeaders":{},)"
+            R"("body":"{\"value\":\"123\"}",)"
+            R"("isBase64Encoded":false})");
+}
+
+TEST(response_writer, should_write_empty_response) {
+  EXPECT_EQ(write_response(not_found()),
+            R"({"statusCode":404,"headers":{},"multiValueHeaders":{},"body":"","isBase64Encoded":false})");
+}
@@ -0,0 +1,75 @@
+//
+// Created by Daniil Ryzhkov on 17/10/2026.
+//
+
+#include <gtest/gtest.h>
+#include <integration_tests_common/benchmark.hpp>
+#include <rest/api_root.hpp>
+
+using namespace rest;
+
+#define BENCHMARK_REQUESTS 100000
+
+struct benchmark_response {
+  int value = 0;
+
+  JSON_BEGIN_SERIALIZER(benchmark_response)
+      JSON_PROPERTY("value", value)
+  JSON_END_SERIALIZER()
+};
+
+// Declares resources shaped as the api ones, each with a list, an item by id and nested years and months.
+static void declare_resources(api_root &api, int count) {
+  api.any("/v1")([count](api_resource &v1) {
+    for (int i = 0; i < count; i++) {
+      v1.any("/resource" + std::to_string(i))([i](api_resource &resource) {
+        resource.get("/")([i]() { return benchmark_response{.value = i}; });
+        resource.del<int>()([](int id) {});
+        resource.any("/years")([](api_resource &years) {
+          years.any<int>()([](basic_api_resource<int> &year) {
+            year.any("/months")([](basic_api_resource<int> &months) {
+              months.get<int>()([](int y, int m) { return benchmark_response{.value = y * 100 + m}; });
+            });
+          });
+        });
+      });
+    }
+  });
+}
+
+// Returns size of the responses as work, equal for the same route whatever number of resources is declared.
+static benchmark::measurement measure_routing(api_root &api, const std::string &method, const std::string &path, int expected_status) {
+  api_request_t request;
+  request.http_method = method;
+  request.path = path;
+  return benchmark::measure<std::nano>(BENCHMARK_REQUESTS, [&]() {
+    auto response = api.route(request, request.path);
+    EXPECT_EQ(response.status_code, expected_status);
+    return response.body.size() + 1;
+  });
+}
+
+TEST(router_benchmark, per_request_routing) {
+  // routing is expected to cost the same for 10 and 1000 resources, as only one level is matched at a time
+  api_root few;
+  declare_resources(few, 10);
+  api_root many;
+  declare_resources(many, 1000);
+
+  struct routing_case {
+    const char *name;
+    const char *method;
+    std::string path;
+    int expected_status;
+  };
+  for (const auto &c : {
+      routing_case{"10 vs 1000 resources, delete by id", "DELETE", "/123", 200},
+      routing_case{"10 vs 1000 resources, nested get with parameters", "GET", "/years/2024/months/10", 200},
+      routing_case{"10 vs 1000 resources, method not allowed", "PUT", "/years/2024/months/10", 405},
+      routing_case{"10 vs 1000 resources, not found", "GET", "/years/2024/weeks/10", 404}}) {
+    // the last declared resource, so that every sibling is passed
+    auto on_few = measure_routing(few, c.method, "/v1/resource9" + c.path, c.expected_status);
+    auto on_many = measure_routing(many, c.method, "/v1/resource999" + c.path, c.expected_status);
+    benchmark::compare(c.name, "ns", on_few, on_many);
+  }
+}
@@ -25,6 +25,7 @@ using namespace repository;
 using namespace repository::models;
 
 #define USER_ID "20a79fcd-1783-475b-9095-35afb0d34b7f"
+#define RECEIPT_ID "6b1f2c3d-4e5f-4a6b-8c7d-000000012345"
 #define DATE "2024-06-22"
 #define IMAGE_NAME DATE ".jpg"
 #define DEFAULT_KEY "users/" USER_ID "/receipts/" IMAGE_NAME
@@ -155,7 +156,7 @@ class scanner_test : public repository_integration_test {
   void SetUp() override {
     repository_integration_test::SetUp();
     auto repo = services.get<t_client>();
-    repo->execute("insert into users (id) values ('" USER_ID "')").go();
+    repo->execute("insert into users (id) values (?)").with_param(guid(USER_ID)).go();
   }
 
  protected:
@@ -166,10 +167,10 @@ class scanner_test : public repository_integration_test {
   receipt create_receipt() {
     auto repo = services.get<t_client>();
     auto r = receipt{
-        .id = "12345",
-        .user_id = USER_ID,
+        .id = guid(RECEIPT_ID),
+        .user_id = guid(USER_ID),
         .date = DATE,
-        .total_amount = 200.00,
+        .total_amount = money::from_cents(20000),
         .currency = "EUR",
         .store_name = "Amazon",
         .category = "",
@@ -187,6 +188,8 @@ class scanner_test : public repository_integration_test {
 
       singleton<Aws::Client::ClientConfiguration>,
       singleton<repository::connection_settings>,
+      singleton<repository::connection_pool>,
+      singleton<repository::replica_pool>,
       singleton<t_client, client<>>,
       transient<t_receipt_repository, receipt_repository<>>,
       transient<t_category_repository, category_repository<>>,
@@ -212,7 +215,7 @@ TEST_F(scanner_test, should_create_receipt) {
   auto receipt = receipts->at(0);
   ASSERT_EQ(receipt->store_name, "Amazon");
   ASSERT_EQ(receipt->date, DATE);
-  ASSERT_EQ(receipt->total_amount, 100.00);
+  ASSERT_EQ(receipt->total_amount, money::from_cents(10000));
   ASSERT_EQ(receipt->version, 0);
   ASSERT_EQ(receipt->image_name, IMAGE_NAME);
 
@@ -221,7 +224,7 @@ TEST_F(scanner_test, should_create_receipt) {
   auto item = items->at(0);
   ASSERT_EQ(item->receipt_id, receipt->id);
   ASSERT_EQ(item->description, "Item 1");
-  ASSERT_EQ(item->amount, 100.00);
+  ASSERT_EQ(item->amount, money::from_cents(10000));
   ASSERT_EQ(item->sort_order, 0);
 }
 
@@ -287,7 +290,7 @@ TEST_F(scanner_test, should_sanitise_amount) {
     auto repo = services.get<t_client>();
     auto receipts = repo->select<receipt>("select * from receipts").all();
     ASSERT_EQ(receipts->size(), 1);
-    ASSERT_EQ(receipts->at(0)->total_amount, 100.00);
+    ASSERT_EQ(receipts->at(0)->total_amount, money::from_cents(10000));
 
     repo->execute("delete from receipts").go();
   };
@@ -308,7 +311,7 @@ TEST_F(scanner_test, should_ignore_amount_if_invalid) {
   auto repo = services.get<t_client>();
   auto receipts = repo->select<receipt>("select * from receipts").all();
   ASSERT_EQ(receipts->size(), 1);
-  ASSERT_EQ(receipts->at(0)->total_amount, 0.00);
+  ASSERT_EQ(receipts->at(0)->total_amount, money());
 }
 
 TEST_F(scanner_test, should_import_currency) {
@@ -358,7 +361,7 @@ TEST_F(scanner_test, should_set_default_quantity) {
   ASSERT_EQ(receipts->size(), 1);
   auto items = repo->select<receipt_item>("select * from receipt_items").all();
   ASSERT_EQ(items->size(), 1);
-  ASSERT_EQ(items->at(0)->amount, 100.00);
+  ASSERT_EQ(items->at(0)->amount, money::from_cents(10000));
 }
 
 TEST_F(scanner_test, should_handle_incorrect_quantity) {
@@ -376,7 +379,7 @@ TEST_F(scanner_test, should_handle_incorrect_quantity) {
   ASSERT_EQ(receipts->size(), 1);
   auto items = repo->select<receipt_item>("select * from receipt_items").all();
   ASSERT_EQ(items->size(), 1);
-  ASSERT_EQ(items->at(0)->amount, 100.00);
+  ASSERT_EQ(items->at(0)->amount, money::from_cents(10000));
 }
 
 TEST_F(scanner_test, should_update_existing_receipt_if_present_by_user_and_image_name) {
@@ -392,7 +395,7 @@ TEST_F(scanner_test, should_update_existing_receipt_if_present_by_user_and_image
   auto receipts = repo->select<receipt>("select * from receipts").all();
   ASSERT_EQ(receipts->size(), 1);
   auto receipt = receipts->at(0);
-  ASSERT_EQ(receipt->total_amount, 100.00);
+  ASSERT_EQ(receipt->total_amount, money::from_cents(10000));
   ASSERT_EQ(receipt->id, r.id);
   ASSERT_EQ(receipt->image_name, IMAGE_NAME);
   ASSERT_EQ(receipt->version, r.version + 1);
@@ -48,6 +48,8 @@ int main(int argc, char* argv[]) {
         container<
             singleton<Aws::Client::ClientConfiguration>,
             singleton<repository::connection_settings>,
+            singleton<repository::connection_pool>,
+            singleton<repository::replica_pool>,
             singleton<TextractClient>,
             singleton<BedrockRuntimeClient>,
             singleton<repository::t_client, repository::client<>>,
@@ -61,7 +63,9 @@ int main(int argc, char* argv[]) {
             transient<t_handler, handler<>>
         > services;
 
-        return services.template get<t_handler>()->operator()(req);
+        auto response = services.template get<t_handler>()->operator()(req);
+        services.template get<repository::t_client>()->flush_metrics();
+        return response;
       };
 
 #ifdef DEBUG
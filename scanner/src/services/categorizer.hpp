@@ -44,27 +44,27 @@ class categorizer {
     if (!receipt.items.empty()) {
       std::string prompt_start_format =
           "\n\nHuman: For each receipt item guess and print a category (only) "
-          "using following categories: %s.\nReceipt: %s %.2Lf %s.\nItems:";
+          "using following categories: %s.\nReceipt: %s %s %s.\nItems:";
 
       payload.prompt = lambda::string::format(
           prompt_start_format, categories_str.c_str(), receipt.store_name.c_str(),
-          receipt.total_amount, receipt.currency.c_str());
+          receipt.total_amount.str().c_str(), receipt.currency.c_str());
 
-      std::string prompt_item_format = "\n%d. %s %.2Lf %s";
+      std::string prompt_item_format = "\n%d. %s %s %s";
 
       for (auto &item : receipt.items) {
         payload.prompt += lambda::string::format(
             prompt_item_format, item.sort_order, item.description.c_str(),
-            item.amount, receipt.currency.c_str());
+            item.amount.str().c_str(), receipt.currency.c_str());
       }
     } else {
       std::string prompt_format =
           "\n\nHuman: Guess and print category (only) of receipt using following "
-          "categories: %s.\nReceipt: %s %.2Lf %s.";
+          "categories: %s.\nReceipt: %s %s %s.";
 
       payload.prompt = lambda::string::format(
           prompt_format, categories_str.c_str(), receipt.store_name.c_str(),
-          receipt.total_amount, receipt.currency.c_str());
+          receipt.total_amount.str().c_str(), receipt.currency.c_str());
     }
 
     payload.prompt += "\n\nAssistant:";
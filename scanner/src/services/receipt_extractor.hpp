@@ -4,6 +4,7 @@
 
 #pragma once
 
+#include <charconv>
 #include <vector>
 
 #include <aws/textract/TextractClient.h>
@@ -33,12 +34,12 @@ class receipt_extractor : t_receipt_extractor {
 
     std::string key_parted = key.substr(6, key.length() - 6);
     auto users_delimiter = key_parted.find('/');
-    guid user_id = key_parted.substr(0, users_delimiter);
+    auto user_id = guid::parse(key_parted.substr(0, users_delimiter));
     key_parted.erase(0, users_delimiter + 10);
     std::string image_name = key_parted;
 
     lambda::log.info("Processing request %s of user %s", image_name.c_str(),
-                     user_id.c_str());
+                     user_id.str().c_str());
 
     Aws::Textract::Model::S3Object s3_object;
     s3_object.WithBucket(bucket).WithName(key);
@@ -64,7 +65,7 @@ class receipt_extractor : t_receipt_extractor {
 
     auto doc = expense_documents[0];
     receipt receipt;
-    receipt.id = utils::gen_uuid();
+    receipt.id = guid::parse(utils::gen_uuid());
     receipt.user_id = user_id;
     receipt.image_name = image_name;
     receipt.state = receipt::processing;
@@ -81,7 +82,8 @@ class receipt_extractor : t_receipt_extractor {
 
   using expense_fields = std::vector<Aws::Textract::Model::ExpenseField>;
   using line_item_groups = std::vector<Aws::Textract::Model::LineItemGroup>;
-  using guid = std::string;
+  using guid = repository::models::guid;
+  using money = repository::models::money;
   using receipt = repository::models::receipt;
   using receipt_item = repository::models::receipt_item;
 
@@ -193,12 +195,11 @@ class receipt_extractor : t_receipt_extractor {
     return parsed;
   }
 
-  bool try_parse_total(long double &result, const std::string &input) const {
+  bool try_parse_total(money &result, const std::string &input) const {
     // Since deducing a locale might not be reliable, because
     // the currency might not be present in the text or decimal
     // separator might be different, we will try to remove all
-    // non-numeric characters and parse the number as a long double
-    // and then divide it by 100 to get the correct value.
+    // non-numeric characters and parse the number as cents.
 
     std::string text(input);
     lambda::string::replace_all(text, ",", "");
@@ -220,19 +221,18 @@ class receipt_extractor : t_receipt_extractor {
 
     if (numeric.empty()) {
       lambda::log.info("No numeric characters found in the total field.");
-      result = 0;
+      result = money();
       return false;
     }
 
-    std::istringstream ss(numeric);
-    long double total;
-    ss >> std::get_money(total);
-    if (ss.fail()) {
+    int64_t cents;
+    auto [end_ptr, error] = std::from_chars(numeric.data(), numeric.data() + numeric.size(), cents);
+    if (error != std::errc()) {
       lambda::log.info("Unable to parse total as currency.");
-      result = 0;
+      result = money();
       return false;
     }
-    result = total / 100.0;
+    result = money::from_cents(cents);
     return true;
   }
 
@@ -274,13 +274,13 @@ class receipt_extractor : t_receipt_extractor {
       } else if ((field_type == receipt_amount || field_type == receipt_total) &&
           best_total_confidence < confidence) {
         receipt.currency = try_get_currency(summary_field);
-        long double found_total = 0;
+        money found_total;
         if (try_parse_total(found_total, value)) {
           best_total_confidence = confidence;
           receipt.total_amount = found_total;
         } else {
           lambda::log.info("Unable to parse found total string %s.", value.c_str());
-          receipt.total_amount = 0;
+          receipt.total_amount = money();
         }
       }
     }
@@ -302,7 +302,7 @@ class receipt_extractor : t_receipt_extractor {
       auto &items = group.GetLineItems();
       for (auto &item : items) {
         receipt_item receipt_item;
-        receipt_item.id = utils::gen_uuid();
+        receipt_item.id = guid::parse(utils::gen_uuid());
         receipt_item.receipt_id = receipt.id;
         receipt_item.sort_order = sort_order;
 
@@ -318,7 +318,7 @@ class receipt_extractor : t_receipt_extractor {
     auto &fields = item.GetLineItemExpenseFields();
 
     int quantity = 1;
-    long double unit_price = 0;
+    money unit_price;
 
     double best_description_confidence = 0;
     double best_amount_confidence = 0;
@@ -335,14 +335,14 @@ class receipt_extractor : t_receipt_extractor {
         best_description_confidence = confidence;
       } else if (field_type == item_price &&
           best_amount_confidence < confidence) {
-        long double found_amount = 0;
+        money found_amount;
         if (try_parse_total(found_amount, value)) {
           best_amount_confidence = confidence;
           receipt_item.amount = found_amount;
         } else {
           lambda::log.info("Unable to parse found amount string %s.",
                            value.c_str());
-          receipt_item.amount = 0;
+          receipt_item.amount = money();
         }
       } else if (field_type == item_quantity &&
           best_quantity_confidence < confidence) {
@@ -363,14 +363,14 @@ class receipt_extractor : t_receipt_extractor {
         }
       } else if (field_type == item_unit_price &&
           best_unit_price_confidence < confidence) {
-        long double found_unit_price = 0;
+        money found_unit_price;
         if (try_parse_total(found_unit_price, value)) {
           best_unit_price_confidence = confidence;
           unit_price = found_unit_price;
         } else {
           lambda::log.info("Unable to parse found unit price string %s.",
                            value.c_str());
-          unit_price = 0;
+          unit_price = money();
         }
       }
     }
@@ -385,17 +385,17 @@ class receipt_extractor : t_receipt_extractor {
                        receipt_item.description.c_str());
     }
 
-    if (receipt_item.amount == 0) {
+    if (receipt_item.amount.is_zero()) {
       receipt_item.amount = quantity * unit_price;
     }
   }
 
-  static receipt create_failed(const std::string &user_id, const std::string &image_name) {
+  static receipt create_failed(const guid &user_id, const std::string &image_name) {
     return receipt{
-        .id = utils::gen_uuid(),
+        .id = guid::parse(utils::gen_uuid()),
         .user_id = user_id,
         .date = lambda::utils::today(),
-        .total_amount = 0,
+        .total_amount = money(),
         .currency = "EUR",
         .store_name = "-",
         .category = "",